@@ -0,0 +1,222 @@
+// Compile-time benchmark, generates translation units instantiating variant and expected
+// and measures wall time, peak compiler memory and object size for each of them.
+// usage: idym_bench_compile_time <compiler> <include-dir> <output-dir> <standard> [flags]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #define IDYM_BENCH_POSIX
+  #include <sys/resource.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+
+struct bench_config {
+    std::string name;
+    std::string standard;
+    std::function<std::string()> generate;
+};
+
+struct bench_result {
+    bool success;
+    double seconds;
+    long peak_kib; // -1 if unavailable
+    long object_size;
+};
+
+// === sources
+std::string variant_source(std::size_t alt_count, bool use_std) {
+    const std::string ns = use_std ? "std" : "idym";
+    std::ostringstream out;
+
+    out << (use_std ? "#include <variant>\n" : "#include <idym/variant.hpp>\n");
+    out << "template<int I> struct alt_t {\n"
+        << "    int value;\n"
+        << "    friend bool operator==(const alt_t& lhs, const alt_t& rhs) { return lhs.value == rhs.value; }\n"
+        << "    friend bool operator!=(const alt_t& lhs, const alt_t& rhs) { return lhs.value != rhs.value; }\n"
+        << "    friend bool operator<(const alt_t& lhs, const alt_t& rhs) { return lhs.value < rhs.value; }\n"
+        << "    friend bool operator>(const alt_t& lhs, const alt_t& rhs) { return lhs.value > rhs.value; }\n"
+        << "    friend bool operator<=(const alt_t& lhs, const alt_t& rhs) { return lhs.value <= rhs.value; }\n"
+        << "    friend bool operator>=(const alt_t& lhs, const alt_t& rhs) { return lhs.value >= rhs.value; }\n"
+        << "};\n";
+
+    out << "using var_t = " << ns << "::variant<";
+    for (std::size_t i = 0; i < alt_count; ++i)
+        out << (i ? ", " : "") << "alt_t<" << i << ">";
+    out << ">;\n";
+
+    // converting construction and assignment go through the overload set, touch both ends and the middle
+    out << "int use(var_t& v, const var_t& w) {\n"
+        << "    var_t first{alt_t<0>{0}};\n"
+        << "    v = alt_t<" << alt_count / 2 << ">{1};\n"
+        << "    v = alt_t<" << alt_count - 1 << ">{2};\n"
+        << "    var_t copy{w};\n"
+        << "    int sum = " << ns << "::visit([](const auto& alt) { return alt.value; }, v);\n"
+        << "    sum += " << ns << "::get<" << alt_count - 1 << ">(w).value;\n"
+        << "    sum += " << ns << "::holds_alternative<alt_t<1>>(first);\n"
+        << "    copy = v;\n"
+        << "    return sum + (copy == v) + (copy < w);\n"
+        << "}\n";
+    return out.str();
+}
+
+// type based lookups at every alternative, each call site names a distinct type
+std::string variant_lookup_source(std::size_t alt_count, bool use_std) {
+    const std::string ns = use_std ? "std" : "idym";
+    std::ostringstream out;
+
+    out << (use_std ? "#include <variant>\n" : "#include <idym/variant.hpp>\n");
+    out << "template<int I> struct alt_t { int value; };\n";
+
+    out << "using var_t = " << ns << "::variant<";
+    for (std::size_t i = 0; i < alt_count; ++i)
+        out << (i ? ", " : "") << "alt_t<" << i << ">";
+    out << ">;\n";
+
+    out << "int use(var_t& v) {\n"
+        << "    int sum = 0;\n";
+    for (std::size_t i = 0; i < alt_count; ++i) {
+        out << "    sum += " << ns << "::holds_alternative<alt_t<" << i << ">>(v) ? " << ns << "::get<alt_t<" << i << ">>(v).value : 0;\n"
+            << "    v.emplace<alt_t<" << i << ">>(alt_t<" << i << ">{sum});\n";
+    }
+    out << "    return sum + " << ns << "::get<" << alt_count - 1 << ">(v).value;\n}\n";
+    return out.str();
+}
+
+// converting assignment from every alternative, each resolves the overload set anew
+std::string variant_convert_source(std::size_t alt_count, bool use_std) {
+    const std::string ns = use_std ? "std" : "idym";
+    std::ostringstream out;
+
+    out << (use_std ? "#include <variant>\n" : "#include <idym/variant.hpp>\n");
+    out << "template<int I> struct alt_t { int value; };\n";
+
+    out << "using var_t = " << ns << "::variant<";
+    for (std::size_t i = 0; i < alt_count; ++i)
+        out << (i ? ", " : "") << "alt_t<" << i << ">";
+    out << ">;\n";
+
+    out << "int use(var_t& v) {\n";
+    for (std::size_t i = 0; i < alt_count; ++i)
+        out << "    v = alt_t<" << i << ">{" << i << "};\n";
+    out << "    return static_cast<int>(v.index());\n}\n";
+    return out.str();
+}
+
+std::string expected_source(std::size_t depth, bool use_std) {
+    const std::string ns = use_std ? "std" : "idym";
+    std::ostringstream out;
+
+    out << (use_std ? "#include <expected>\n" : "#include <idym/expected.hpp>\n");
+    out << "template<int I> struct step_t { int value; };\n";
+    out << "int use(" << ns << "::expected<step_t<0>, int> e) {\n"
+        << "    return std::move(e)";
+    for (std::size_t i = 0; i < depth; ++i) {
+        out << "\n        .and_then([](step_t<" << i << "> s) { return " << ns << "::expected<step_t<" << i + 1 << ">, int>{step_t<"
+            << i + 1 << ">{s.value + 1}}; })";
+    }
+    out << "\n        .value_or(step_t<" << depth << ">{-1}).value;\n}\n";
+    return out.str();
+}
+
+// === measurement
+long file_size(const std::string& path) {
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file)
+        return -1;
+    return static_cast<long>(file.tellg());
+}
+
+bench_result run_compiler(const std::string& command) {
+    bench_result result{false, 0.0, -1, -1};
+    const auto start = std::chrono::steady_clock::now();
+
+#ifdef IDYM_BENCH_POSIX
+    // wait4 reports the usage of this compiler run alone, RUSAGE_CHILDREN would accumulate
+    const pid_t pid = fork();
+    if (pid == 0) {
+        execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    rusage usage{};
+    if (pid > 0 && wait4(pid, &status, 0, &usage) == pid) {
+        result.success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  #ifdef __APPLE__
+        result.peak_kib = usage.ru_maxrss / 1024;
+  #else
+        result.peak_kib = usage.ru_maxrss;
+  #endif
+    }
+#else
+    result.success = std::system(command.c_str()) == 0;
+#endif
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        std::cerr << "usage: " << argv[0] << " <compiler> <include-dir> <output-dir> <standard> [flags]\n";
+        return 1;
+    }
+    const std::string compiler = argv[1];
+    const std::string include_dir = argv[2];
+    const std::string output_dir = argv[3];
+    const std::string standard = argv[4];
+    const std::string flags = argc > 5 ? argv[5] : "-O2";
+
+    std::vector<bench_config> configs;
+    for (std::size_t alt_count : {8, 32, 128, 256}) {
+        configs.push_back({"idym_variant_" + std::to_string(alt_count), standard, [=] { return variant_source(alt_count, false); }});
+        configs.push_back({"std_variant_" + std::to_string(alt_count), "17", [=] { return variant_source(alt_count, true); }});
+    }
+    for (std::size_t alt_count : {64, 256}) {
+        configs.push_back({"idym_lookup_" + std::to_string(alt_count), standard, [=] { return variant_lookup_source(alt_count, false); }});
+        configs.push_back({"std_lookup_" + std::to_string(alt_count), "17", [=] { return variant_lookup_source(alt_count, true); }});
+        configs.push_back({"idym_convert_" + std::to_string(alt_count), standard, [=] { return variant_convert_source(alt_count, false); }});
+        configs.push_back({"std_convert_" + std::to_string(alt_count), "17", [=] { return variant_convert_source(alt_count, true); }});
+    }
+    for (std::size_t depth : {8, 32, 64}) {
+        configs.push_back({"idym_expected_" + std::to_string(depth), standard, [=] { return expected_source(depth, false); }});
+        configs.push_back({"std_expected_" + std::to_string(depth), "23", [=] { return expected_source(depth, true); }});
+    }
+
+    std::printf("compiler: %s, flags: %s\n", compiler.c_str(), flags.c_str());
+    std::printf("%-22s %-6s %10s %12s %12s\n", "config", "std", "time [s]", "peak [KiB]", "object [B]");
+
+    bool all_idym_compiled = true;
+    for (const auto& config : configs) {
+        const std::string base = output_dir + "/" + config.name;
+        std::ofstream{base + ".cpp"} << config.generate();
+
+        const std::string command = compiler + " -std=c++" + config.standard + " " + flags + " -I\"" + include_dir + "\" -c \"" +
+            base + ".cpp\" -o \"" + base + ".o\" > \"" + base + ".log\" 2>&1";
+        const bench_result result = run_compiler(command);
+
+        // the std comparisons are optional, the library or language version may be missing
+        if (!result.success) {
+            std::printf("%-22s %-6s %10s %12s %12s\n", config.name.c_str(), config.standard.c_str(), "n/a", "n/a", "n/a");
+            all_idym_compiled = all_idym_compiled && config.name.compare(0, 5, "idym_") != 0;
+            continue;
+        }
+        std::printf(
+            "%-22s %-6s %10.2f %12ld %12ld\n",
+            config.name.c_str(), config.standard.c_str(), result.seconds, result.peak_kib, file_size(base + ".o")
+        );
+    }
+    return all_idym_compiled ? 0 : 1;
+}
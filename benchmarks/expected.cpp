@@ -0,0 +1,289 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <idym/expected.hpp>
+
+#include "idym_bench.hpp"
+
+struct parse_error {
+    int code;
+};
+struct parse_exception {
+    int code;
+};
+
+using result_t = idym::expected<int, parse_error>;
+
+constexpr std::size_t element_count = 4096;
+constexpr std::size_t call_count = 200;
+
+// negative inputs fail to parse
+std::vector<int> make_inputs(unsigned success_percent) {
+    idym_bench::lcg rng{42};
+    std::vector<int> inputs(element_count);
+    for (auto& input : inputs) {
+        const int value = static_cast<int>(rng() & 0xffff);
+        input = rng() % 100 < success_percent ? value : -value - 1;
+    }
+    return inputs;
+}
+
+result_t parse(int input) {
+    if (input < 0)
+        return result_t{idym::unexpect, parse_error{input}};
+    return result_t{input};
+}
+int parse_throw(int input) {
+    if (input < 0)
+        throw parse_exception{input};
+    return input;
+}
+
+// === chains
+template<typename Op>
+result_t apply_chain(std::integral_constant<std::size_t, 0>, result_t r, Op) {
+    return r;
+}
+template<std::size_t Depth, typename Op>
+result_t apply_chain(std::integral_constant<std::size_t, Depth>, result_t r, Op op) {
+    return apply_chain(std::integral_constant<std::size_t, Depth - 1>{}, op(std::move(r)), op);
+}
+
+struct and_then_op {
+    result_t operator()(result_t&& r) const {
+        return std::move(r).and_then([](int v) { return result_t{v + 1}; });
+    }
+};
+struct or_else_op {
+    result_t operator()(result_t&& r) const {
+        return std::move(r).or_else([](parse_error e) { return result_t{idym::unexpect, parse_error{e.code - 1}}; });
+    }
+};
+struct transform_op {
+    result_t operator()(result_t&& r) const {
+        return std::move(r).transform([](int v) { return v + 1; });
+    }
+};
+struct transform_error_op {
+    result_t operator()(result_t&& r) const {
+        return std::move(r).transform_error([](parse_error e) { return parse_error{e.code - 1}; });
+    }
+};
+
+template<std::size_t Depth, typename Op>
+double bench_chain(const std::vector<int>& inputs) {
+    return idym_bench::measure(element_count, call_count, [&inputs] {
+        int sum = 0;
+        for (int input : inputs) {
+            const result_t r = apply_chain(std::integral_constant<std::size_t, Depth>{}, parse(input), Op{});
+            sum += r.has_value() ? *r : r.error().code;
+        }
+        idym_bench::do_not_optimize(sum);
+    });
+}
+
+// the same chain written against exceptions, a step per level
+template<std::size_t Depth>
+double bench_chain_exceptions(const std::vector<int>& inputs) {
+    return idym_bench::measure(element_count, call_count, [&inputs] {
+        int sum = 0;
+        for (int input : inputs) {
+            try {
+                int v = parse_throw(input);
+                for (std::size_t i = 0; i < Depth; ++i) {
+                    v = v + 1;
+                    idym_bench::do_not_optimize(v);
+                }
+                sum += v;
+            } catch (const parse_exception& e) {
+                sum += e.code;
+            }
+        }
+        idym_bench::do_not_optimize(sum);
+    });
+}
+
+template<std::size_t Depth>
+void run_chains(unsigned success_percent) {
+    const std::vector<int> inputs = make_inputs(success_percent);
+    const std::string config = "depth " + std::to_string(Depth) + ", " + std::to_string(success_percent) + "% ok";
+    const double exceptions = bench_chain_exceptions<Depth>(inputs);
+
+    idym_bench::print_row("and_then", config, bench_chain<Depth, and_then_op>(inputs), exceptions);
+    idym_bench::print_row("or_else", config, bench_chain<Depth, or_else_op>(inputs), exceptions);
+    idym_bench::print_row("transform", config, bench_chain<Depth, transform_op>(inputs), exceptions);
+    idym_bench::print_row("transform_err", config, bench_chain<Depth, transform_error_op>(inputs), exceptions);
+}
+
+void run_value_or(unsigned success_percent) {
+    const std::vector<int> inputs = make_inputs(success_percent);
+    const std::string config = std::to_string(success_percent) + "% ok";
+
+    const double expected_ns = idym_bench::measure(element_count, call_count, [&inputs] {
+        int sum = 0;
+        for (int input : inputs)
+            sum += parse(input).value_or(0);
+        idym_bench::do_not_optimize(sum);
+    });
+    const double exceptions_ns = idym_bench::measure(element_count, call_count, [&inputs] {
+        int sum = 0;
+        for (int input : inputs) {
+            try {
+                sum += parse_throw(input);
+            } catch (const parse_exception&) {}
+        }
+        idym_bench::do_not_optimize(sum);
+    });
+    idym_bench::print_row("value_or", config, expected_ns, exceptions_ns);
+}
+
+// === object operations, against the bare value type
+template<typename T>
+T make_value(std::uint32_t seed, T*) {
+    return static_cast<T>(seed);
+}
+std::string make_value(std::uint32_t seed, std::string*) {
+    return "value " + std::to_string(seed);
+}
+
+template<typename T>
+struct object_bench {
+    using expected_t = idym::expected<T, parse_error>;
+
+    object_bench(unsigned success_percent) {
+        idym_bench::lcg rng{42};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            const std::uint32_t seed = rng();
+            values.push_back(make_value(seed, static_cast<T*>(nullptr)));
+            if (rng() % 100 < success_percent)
+                expecteds.emplace_back(idym::in_place, values.back());
+            else
+                expecteds.emplace_back(idym::unexpect, parse_error{static_cast<int>(seed)});
+        }
+    }
+
+    template<typename Container_T>
+    static double copy(const Container_T& source) {
+        return idym_bench::measure(element_count, call_count, [&source] {
+            for (const auto& element : source) {
+                auto copy = element;
+                idym_bench::do_not_optimize(copy);
+            }
+        });
+    }
+    template<typename Container_T>
+    static double move(Container_T& source) {
+        return idym_bench::measure(element_count, call_count, [&source] {
+            for (auto& element : source) {
+                auto moved = std::move(element);
+                idym_bench::do_not_optimize(moved);
+                element = std::move(moved);
+            }
+        });
+    }
+    template<typename Container_T>
+    static double swap(Container_T& source) {
+        return idym_bench::measure(element_count - 1, call_count, [&source] {
+            using std::swap;
+            for (std::size_t i = 0; i + 1 < element_count; ++i)
+                swap(source[i], source[i + 1]);
+        });
+    }
+
+    std::vector<T> values;
+    std::vector<expected_t> expecteds;
+};
+
+template<typename T>
+void run_object(const char* type_name, unsigned success_percent) {
+    object_bench<T> bench{success_percent};
+    const std::string config = std::string{type_name} + ", " + std::to_string(success_percent) + "% ok";
+
+    idym_bench::print_row("copy", config, bench.copy(bench.expecteds), bench.copy(bench.values));
+    idym_bench::print_row("move", config, bench.move(bench.expecteds), bench.move(bench.values));
+    idym_bench::print_row("swap", config, bench.swap(bench.expecteds), bench.swap(bench.values));
+}
+
+// === mixed triviality, a trivial value next to a std::string error, against a raw int and flag
+struct int_and_flag {
+    int value;
+    bool has_val;
+};
+
+struct mixed_bench {
+    using expected_t = idym::expected<int, std::string>;
+
+    mixed_bench(unsigned success_percent) {
+        idym_bench::lcg rng{42};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            const bool ok = rng() % 100 < success_percent;
+            const int seed = static_cast<int>(rng());
+            raws.push_back(int_and_flag{seed, ok});
+            if (ok)
+                expecteds.emplace_back(seed);
+            else
+                expecteds.emplace_back(idym::unexpect, "error " + std::to_string(seed));
+        }
+        raw_dest = raws;
+        expected_dest = expecteds;
+    }
+
+    template<typename Container_T>
+    static double copy(const Container_T& source) {
+        return idym_bench::measure(element_count, call_count, [&source] {
+            for (const auto& element : source) {
+                auto copy = element;
+                idym_bench::do_not_optimize(copy);
+            }
+        });
+    }
+    // reversed source, states change wherever the two ends disagree
+    template<typename Container_T>
+    static double assign(Container_T& dest, const Container_T& source) {
+        return idym_bench::measure(element_count, call_count, [&dest, &source] {
+            for (std::size_t i = 0; i < element_count; ++i)
+                dest[i] = source[element_count - 1 - i];
+        });
+    }
+
+    std::vector<int_and_flag> raws;
+    std::vector<int_and_flag> raw_dest;
+    std::vector<expected_t> expecteds;
+    std::vector<expected_t> expected_dest;
+};
+
+void run_mixed(unsigned success_percent) {
+    mixed_bench bench{success_percent};
+    const std::string config = "int, std::string, " + std::to_string(success_percent) + "% ok";
+
+    idym_bench::print_row("copy", config, bench.copy(bench.expecteds), bench.copy(bench.raws));
+    idym_bench::print_row("assign", config, bench.assign(bench.expected_dest, bench.expecteds), bench.assign(bench.raw_dest, bench.raws));
+}
+
+int main(int, char**) {
+    const unsigned success_ratios[] = {100, 99, 50};
+
+    idym_bench::print_header("config", "expected [ns/op]", "throw [ns/op]");
+    for (unsigned ratio : success_ratios) {
+        run_chains<1>(ratio);
+        run_chains<2>(ratio);
+        run_chains<4>(ratio);
+        run_chains<8>(ratio);
+        run_chains<16>(ratio);
+    }
+    for (unsigned ratio : success_ratios)
+        run_value_or(ratio);
+
+    std::printf("\n");
+    idym_bench::print_header("config", "expected [ns/op]", "T [ns/op]");
+    for (unsigned ratio : success_ratios) {
+        run_object<int>("int", ratio);
+        run_object<std::string>("std::string", ratio);
+    }
+
+    std::printf("\n");
+    idym_bench::print_header("config", "expected [ns/op]", "int + flag [ns/op]");
+    for (unsigned ratio : success_ratios)
+        run_mixed(ratio);
+}
@@ -0,0 +1,103 @@
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <idym/variant.hpp>
+#include <idym/expected.hpp>
+
+#include "idym_bench.hpp"
+
+using var_t = idym::variant<int, unsigned, std::string>;
+using expected_t = idym::expected<int, int>;
+
+constexpr std::size_t key_count = 4096;
+constexpr std::size_t call_count = 200;
+
+// === the alternative's hash alone, what hashing looked like before the index was mixed in
+struct unmixed_var_hash {
+    std::size_t operator()(const var_t& v) const {
+        return idym::visit([](const auto& alt) { return std::hash<std::decay_t<decltype(alt)>>{}(alt); }, v);
+    }
+};
+struct unmixed_expected_hash {
+    std::size_t operator()(const expected_t& ex) const {
+        return ex.has_value() ? std::hash<int>{}(*ex) : std::hash<int>{}(ex.error());
+    }
+};
+
+// === key sets, the same payloads spread over the alternatives
+std::vector<var_t> make_var_keys(bool strided) {
+    std::vector<var_t> keys;
+    for (std::size_t i = 0; keys.size() < key_count; ++i) {
+        const int value = static_cast<int>(strided ? i * 4096 : i);
+        keys.emplace_back(idym::in_place_index<0>, value);
+        keys.emplace_back(idym::in_place_index<1>, static_cast<unsigned>(value));
+    }
+    return keys;
+}
+std::vector<expected_t> make_expected_keys(bool strided) {
+    std::vector<expected_t> keys;
+    for (std::size_t i = 0; keys.size() < key_count; ++i) {
+        const int value = static_cast<int>(strided ? i * 4096 : i);
+        keys.emplace_back(idym::in_place, value);
+        keys.emplace_back(idym::unexpect, value);
+    }
+    return keys;
+}
+
+// keys sharing a bucket with an earlier key in a power of two table, lower is better
+template<typename Hash, typename Key_T>
+double colliding_keys(const std::vector<Key_T>& keys) {
+    std::vector<bool> occupied(key_count);
+    std::size_t collisions = 0;
+    for (const auto& key : keys) {
+        const std::size_t bucket = Hash{}(key) & (key_count - 1);
+        collisions += occupied[bucket];
+        occupied[bucket] = true;
+    }
+    return static_cast<double>(collisions);
+}
+
+template<typename Hash, typename Key_T>
+double hash_ns(const std::vector<Key_T>& keys) {
+    return idym_bench::measure(keys.size(), call_count, [&keys] {
+        std::size_t sum = 0;
+        for (const auto& key : keys)
+            sum += Hash{}(key);
+        idym_bench::do_not_optimize(sum);
+    });
+}
+
+// probed in a shuffled order, insertion order would favor hashes keeping neighbouring keys in neighbouring buckets
+template<typename Hash, typename Key_T>
+double lookup_ns(const std::vector<Key_T>& keys) {
+    const std::unordered_set<Key_T, Hash> set(keys.begin(), keys.end());
+    std::vector<Key_T> probes = keys;
+    idym_bench::lcg rng{42};
+    for (std::size_t i = probes.size(); i > 1; --i)
+        std::swap(probes[i - 1], probes[rng() % i]);
+
+    return idym_bench::measure(probes.size(), call_count, [&probes, &set] {
+        std::size_t found = 0;
+        for (const auto& key : probes)
+            found += set.count(key);
+        idym_bench::do_not_optimize(found);
+    });
+}
+
+template<typename Hash, typename Unmixed_Hash, typename Key_T>
+void run_keys(const char* type_name, const char* set_name, const std::vector<Key_T>& keys) {
+    const std::string config = std::string{type_name} + ", " + set_name;
+    idym_bench::print_row("collisions", config, colliding_keys<Hash>(keys), colliding_keys<Unmixed_Hash>(keys));
+    idym_bench::print_row("hash", config, hash_ns<Hash>(keys), hash_ns<Unmixed_Hash>(keys));
+    idym_bench::print_row("lookup", config, lookup_ns<Hash>(keys), lookup_ns<Unmixed_Hash>(keys));
+}
+
+int main(int, char**) {
+    idym_bench::print_header("config", "idym", "unmixed");
+
+    run_keys<std::hash<var_t>, unmixed_var_hash>("variant", "sequential", make_var_keys(false));
+    run_keys<std::hash<var_t>, unmixed_var_hash>("variant", "strided", make_var_keys(true));
+    run_keys<std::hash<expected_t>, unmixed_expected_hash>("expected", "sequential", make_expected_keys(false));
+    run_keys<std::hash<expected_t>, unmixed_expected_hash>("expected", "strided", make_expected_keys(true));
+}
@@ -0,0 +1,81 @@
+#ifndef IDYM_BENCH_H
+#define IDYM_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace idym_bench {
+
+// keeps the optimizer from discarding a value or hoisting it out of the loop
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// deterministic pseudo random sequence, same inputs across runs and libraries
+struct lcg {
+    std::uint32_t state;
+
+    std::uint32_t operator()() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+};
+
+constexpr int default_repeats = 5;
+
+// ns per operation, best of repeated runs, fn performs ops_per_call operations
+template<typename F>
+double measure(std::size_t ops_per_call, std::size_t calls, F&& fn, int repeats = default_repeats) {
+    fn(); // warm up
+
+    double best = 0.0;
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t j = 0; j < calls; ++j) {
+            fn();
+            clobber_memory();
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        const double per_op = elapsed / static_cast<double>(ops_per_call * calls);
+        best = i == 0 ? per_op : std::min(best, per_op);
+    }
+    return best;
+}
+
+inline void print_header(const char* config_title, const char* lhs_title, const char* rhs_title) {
+    std::printf("%-14s %-28s %14s %14s %8s\n", "op", config_title, lhs_title, rhs_title, "ratio");
+}
+// a negative time marks an unsupported operation
+inline void print_row(const std::string& op, const std::string& config, double lhs_ns, double rhs_ns) {
+    char lhs[32] = "n/a";
+    char rhs[32] = "n/a";
+    char ratio[32] = "n/a";
+    if (lhs_ns >= 0.0)
+        std::snprintf(lhs, sizeof(lhs), "%.3f", lhs_ns);
+    if (rhs_ns >= 0.0)
+        std::snprintf(rhs, sizeof(rhs), "%.3f", rhs_ns);
+    if (lhs_ns >= 0.0 && rhs_ns > 0.0)
+        std::snprintf(ratio, sizeof(ratio), "%.2f", lhs_ns / rhs_ns);
+    std::printf("%-14s %-28s %14s %14s %8s\n", op.c_str(), config.c_str(), lhs, rhs, ratio);
+}
+
+}
+
+#endif
@@ -0,0 +1,480 @@
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <idym/variant.hpp>
+#include <idym/variant_range.hpp>
+#include <idym/variant_vector.hpp>
+#include <idym/memory.hpp>
+
+#include "idym_bench.hpp"
+
+template<std::size_t I, std::size_t Size>
+struct payload {
+    payload() = default;
+    explicit payload(std::uint32_t seed) {
+        for (std::size_t i = 0; i < Size; ++i)
+            data[i] = static_cast<unsigned char>(seed + i);
+    }
+
+    friend bool operator==(const payload& lhs, const payload& rhs) { return std::memcmp(lhs.data, rhs.data, Size) == 0; }
+    friend bool operator<(const payload& lhs, const payload& rhs) { return std::memcmp(lhs.data, rhs.data, Size) < 0; }
+
+    unsigned char data[Size] = {};
+};
+
+namespace std {
+template<std::size_t I, std::size_t Size>
+struct hash<payload<I, Size>> {
+    std::size_t operator()(const payload<I, Size>& value) const {
+        std::size_t ret = 14695981039346656037ull;
+        for (auto byte : value.data)
+            ret = (ret ^ byte) * 1099511628211ull;
+        return ret;
+    }
+};
+}
+
+// === library policies
+struct idym_api {
+    template<typename... Ts>
+    using variant = idym::variant<Ts...>;
+
+    template<typename Visitor, typename Var_T>
+    static decltype(auto) visit(Visitor&& vis, Var_T&& v) { return idym::visit(std::forward<Visitor>(vis), std::forward<Var_T>(v)); }
+    template<std::size_t I, typename Var_T>
+    static auto get_if(const Var_T& v) { return idym::get_if<I>(&v); }
+};
+struct std_api {
+    template<typename... Ts>
+    using variant = std::variant<Ts...>;
+
+    template<typename Visitor, typename Var_T>
+    static decltype(auto) visit(Visitor&& vis, Var_T&& v) { return std::visit(std::forward<Visitor>(vis), std::forward<Var_T>(v)); }
+    template<std::size_t I, typename Var_T>
+    static auto get_if(const Var_T& v) { return std::get_if<I>(&v); }
+};
+
+template<typename T, typename = void>
+struct is_hashable : std::false_type {};
+template<typename T>
+struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>> : std::true_type {};
+
+// === benchmark body
+constexpr std::size_t element_count = 4096;
+constexpr std::size_t call_count = 200;
+
+template<typename Api, std::size_t Size, std::size_t... Is>
+typename Api::template variant<payload<Is, Size>...> make_variant(std::index_sequence<Is...>);
+
+template<typename Api, std::size_t AltCount, std::size_t Size>
+struct variant_bench {
+    using var_t = decltype(make_variant<Api, Size>(std::make_index_sequence<AltCount>{}));
+
+    template<std::size_t... Is>
+    static void emplace_at(var_t& v, std::size_t index, std::uint32_t seed, std::index_sequence<Is...>) {
+        using emplace_fn_t = void(*)(var_t&, std::uint32_t);
+        const emplace_fn_t emplacers[] = {[](var_t& target, std::uint32_t value) { target.template emplace<Is>(value); }...};
+        emplacers[index](v, seed);
+    }
+
+    variant_bench() : vars(element_count), scratch(element_count) {
+        idym_bench::lcg rng{42};
+        for (auto& v : vars)
+            emplace_at(v, rng() % AltCount, rng(), std::make_index_sequence<AltCount>{});
+        scratch = vars;
+    }
+
+    double visit() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            unsigned sum = 0;
+            for (const auto& v : vars)
+                sum += Api::visit([](const auto& alt) { return alt.data[0]; }, v);
+            idym_bench::do_not_optimize(sum);
+        });
+    }
+    double get_if() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            unsigned sum = 0;
+            for (const auto& v : vars) {
+                if (const auto* alt = Api::template get_if<0>(v))
+                    sum += alt->data[0];
+            }
+            idym_bench::do_not_optimize(sum);
+        });
+    }
+    double copy_ctor() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            for (const auto& v : vars) {
+                var_t copy{v};
+                idym_bench::do_not_optimize(copy);
+            }
+        });
+    }
+    double move_ctor() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            for (auto& v : scratch) {
+                var_t moved{std::move(v)};
+                idym_bench::do_not_optimize(moved);
+            }
+        });
+    }
+    double emplace() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            std::uint32_t seed = 0;
+            for (auto& v : scratch) {
+                v.template emplace<AltCount - 1>(++seed);
+                idym_bench::do_not_optimize(v);
+            }
+        });
+    }
+    double swap() {
+        scratch = vars;
+        return idym_bench::measure(element_count - 1, call_count, [this] {
+            for (std::size_t i = 0; i + 1 < element_count; ++i)
+                scratch[i].swap(scratch[i + 1]);
+        });
+    }
+    double less() {
+        return idym_bench::measure(element_count - 1, call_count, [this] {
+            unsigned count = 0;
+            for (std::size_t i = 0; i + 1 < element_count; ++i)
+                count += vars[i] < vars[i + 1];
+            idym_bench::do_not_optimize(count);
+        });
+    }
+    double hash() {
+        return hash_impl(is_hashable<var_t>{});
+    }
+
+    double hash_impl(std::true_type) {
+        return idym_bench::measure(element_count, call_count, [this] {
+            std::size_t sum = 0;
+            for (const auto& v : vars)
+                sum += std::hash<var_t>{}(v);
+            idym_bench::do_not_optimize(sum);
+        });
+    }
+    double hash_impl(std::false_type) {
+        return -1.0;
+    }
+
+    std::vector<var_t> vars;
+    std::vector<var_t> scratch;
+};
+
+template<std::size_t AltCount, std::size_t Size>
+void run_config() {
+    variant_bench<idym_api, AltCount, Size> idym_bench;
+    variant_bench<std_api, AltCount, Size> std_bench;
+    const std::string config = std::to_string(AltCount) + " alts, " + std::to_string(Size) + " B payload";
+
+    using bench_fn_t = double (variant_bench<idym_api, AltCount, Size>::*)();
+    using std_bench_fn_t = double (variant_bench<std_api, AltCount, Size>::*)();
+    const struct {
+        const char* name;
+        bench_fn_t idym_fn;
+        std_bench_fn_t std_fn;
+    } ops[] = {
+        {"visit", &variant_bench<idym_api, AltCount, Size>::visit, &variant_bench<std_api, AltCount, Size>::visit},
+        {"get_if", &variant_bench<idym_api, AltCount, Size>::get_if, &variant_bench<std_api, AltCount, Size>::get_if},
+        {"copy_ctor", &variant_bench<idym_api, AltCount, Size>::copy_ctor, &variant_bench<std_api, AltCount, Size>::copy_ctor},
+        {"move_ctor", &variant_bench<idym_api, AltCount, Size>::move_ctor, &variant_bench<std_api, AltCount, Size>::move_ctor},
+        {"emplace", &variant_bench<idym_api, AltCount, Size>::emplace, &variant_bench<std_api, AltCount, Size>::emplace},
+        {"swap", &variant_bench<idym_api, AltCount, Size>::swap, &variant_bench<std_api, AltCount, Size>::swap},
+        {"operator<", &variant_bench<idym_api, AltCount, Size>::less, &variant_bench<std_api, AltCount, Size>::less},
+        {"hash", &variant_bench<idym_api, AltCount, Size>::hash, &variant_bench<std_api, AltCount, Size>::hash},
+    };
+    for (const auto& op : ops)
+        idym_bench::print_row(op.name, config, (idym_bench.*op.idym_fn)(), (std_bench.*op.std_fn)());
+}
+
+// === batch visit, per element visit against visit_range over the same elements
+// reads a different byte per alternative, so the calls can't collapse into a single load
+struct alt_visitor {
+    template<std::size_t I, std::size_t Size>
+    unsigned operator()(const payload<I, Size>& alt) const { return alt.data[I % Size] * static_cast<unsigned>(I + 1); }
+};
+
+template<std::size_t AltCount, std::size_t Size>
+void run_range_config() {
+    variant_bench<idym_api, AltCount, Size> bench;
+    const std::string config = std::to_string(AltCount) + " alts, " + std::to_string(Size) + " B payload";
+    const auto& vars = bench.vars;
+
+    const double visit_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        for (const auto& v : vars)
+            sum += idym::visit(alt_visitor{}, v);
+        idym_bench::do_not_optimize(sum);
+    });
+    const double range_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        idym::visit_range([&sum](const auto& alt) { sum += alt_visitor{}(alt); }, vars.begin(), vars.end());
+        idym_bench::do_not_optimize(sum);
+    });
+    const double indexed_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        idym::visit_range_indexed([&sum](std::size_t pos, const auto& alt) { sum += alt_visitor{}(alt) ^ pos; }, vars.begin(), vars.end());
+        idym_bench::do_not_optimize(sum);
+    });
+    idym_bench::print_row("visit_range", config, range_ns, visit_ns);
+    idym_bench::print_row("range_indexed", config, indexed_ns, visit_ns);
+}
+
+// === skewed visit, visit_likely on the hot alternative against visit, the rest spread evenly over the cold ones
+template<std::size_t AltCount, unsigned HotPercent>
+void run_skewed_config() {
+    using bench_t = variant_bench<idym_api, AltCount, 8>;
+    std::vector<typename bench_t::var_t> vars(element_count);
+    idym_bench::lcg rng{42};
+    for (auto& v : vars) {
+        const std::size_t index = rng() % 100 < HotPercent ? 0 : 1 + rng() % (AltCount - 1);
+        bench_t::emplace_at(v, index, rng(), std::make_index_sequence<AltCount>{});
+    }
+    const std::string config = std::to_string(AltCount) + " alts, " + std::to_string(HotPercent) + "% hot";
+
+    const double likely_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        for (const auto& v : vars)
+            sum += idym::visit_likely<0>(alt_visitor{}, v);
+        idym_bench::do_not_optimize(sum);
+    });
+    const double visit_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        for (const auto& v : vars)
+            sum += idym::visit(alt_visitor{}, v);
+        idym_bench::do_not_optimize(sum);
+    });
+    idym_bench::print_row("visit_likely", config, likely_ns, visit_ns);
+}
+
+// === partitioned storage, a common small alternative and a rare large one
+template<unsigned RarePercent>
+void run_partitioned_config() {
+    using common_t = payload<0, 16>;
+    using rare_t = payload<1, 200>;
+
+    std::vector<idym::variant<common_t, rare_t>> vars;
+    idym::variant_vector<common_t, rare_t> partitioned;
+    idym_bench::lcg rng{42};
+    for (std::size_t i = 0; i < element_count; ++i) {
+        const std::uint32_t seed = rng();
+        if (rng() % 100 < RarePercent) {
+            vars.emplace_back(idym::in_place_index<1>, seed);
+            partitioned.emplace_back<1>(seed);
+        } else {
+            vars.emplace_back(idym::in_place_index<0>, seed);
+            partitioned.emplace_back<0>(seed);
+        }
+    }
+
+    const std::size_t vector_bytes = vars.size() * sizeof(vars[0]);
+    const std::size_t partitioned_bytes = partitioned.size() * (sizeof(unsigned char) + sizeof(std::size_t)) +
+        partitioned.count<0>() * sizeof(common_t) + partitioned.count<1>() * sizeof(rare_t);
+    const std::string config = std::to_string(RarePercent) + "% rare, " + std::to_string(partitioned_bytes / 1024) + "/" +
+        std::to_string(vector_bytes / 1024) + " KiB";
+
+    const double partitioned_ns = idym_bench::measure(element_count, call_count, [&partitioned] {
+        unsigned sum = 0;
+        partitioned.visit_all([&sum](const auto& alt) { sum += alt.data[1]; });
+        idym_bench::do_not_optimize(sum);
+    });
+    const double vector_ns = idym_bench::measure(element_count, call_count, [&vars] {
+        unsigned sum = 0;
+        for (const auto& v : vars)
+            sum += idym::visit([](const auto& alt) { return alt.data[1]; }, v);
+        idym_bench::do_not_optimize(sum);
+    });
+    idym_bench::print_row("visit_all", config, partitioned_ns, vector_ns);
+}
+
+// === boxed alternatives, a capped variant boxing a rare large alternative against the inline one
+template<unsigned RarePercent>
+void run_boxed_config() {
+    using common_t = payload<0, 8>;
+    using rare_t = payload<1, 512>;
+    using inline_t = idym::variant<common_t, rare_t>;
+    using capped_t = idym::capped_variant<16, common_t, rare_t>;
+
+    std::vector<inline_t> inline_vars;
+    std::vector<capped_t> capped_vars;
+    idym_bench::lcg rng{42};
+    for (std::size_t i = 0; i < element_count; ++i) {
+        const std::uint32_t seed = rng();
+        if (rng() % 100 < RarePercent) {
+            inline_vars.emplace_back(idym::in_place_index<1>, seed);
+            capped_vars.emplace_back(idym::in_place_index<1>, idym::in_place, seed);
+        } else {
+            inline_vars.emplace_back(idym::in_place_index<0>, seed);
+            capped_vars.emplace_back(idym::in_place_index<0>, seed);
+        }
+    }
+    const std::string config = std::to_string(RarePercent) + "% rare, " + std::to_string(sizeof(capped_t)) + "/" +
+        std::to_string(sizeof(inline_t)) + " B";
+
+    const auto visit_all = [](const auto& vars) {
+        return idym_bench::measure(element_count, call_count, [&vars] {
+            unsigned sum = 0;
+            for (const auto& v : vars)
+                sum += idym::visit([](const auto& alt) { return alt.data[1]; }, v);
+            idym_bench::do_not_optimize(sum);
+        });
+    };
+    const auto copy_all = [](const auto& vars) {
+        return idym_bench::measure(element_count, call_count, [&vars] {
+            auto copy = vars;
+            idym_bench::do_not_optimize(copy);
+        });
+    };
+    idym_bench::print_row("visit", config, visit_all(capped_vars), visit_all(inline_vars));
+    idym_bench::print_row("copy", config, copy_all(capped_vars), copy_all(inline_vars));
+}
+
+// === relocation, message-like alternatives opting into trivial relocation
+template<typename Var_T>
+struct relocation_bench {
+    relocation_bench() {
+        idym_bench::lcg rng{42};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            if (rng() % 2 == 0)
+                vars.emplace_back(std::make_unique<int>(static_cast<int>(i)));
+            else
+                vars.emplace_back(static_cast<int>(i));
+        }
+    }
+
+    // disjoint pairs, chained neighbours would measure store forwarding between consecutive swaps
+    double swap() {
+        return idym_bench::measure(element_count / 2, call_count, [this] {
+            for (std::size_t i = 0; i < element_count / 2; ++i)
+                vars[i].swap(vars[i + element_count / 2]);
+        });
+    }
+    // moves every element to a second buffer and back, as a container growing twice
+    template<typename Relocate_Fn>
+    double relocate(Relocate_Fn relocate_fn) {
+        std::allocator<Var_T> alloc;
+        Var_T* other = alloc.allocate(element_count);
+        const double ns = idym_bench::measure(2 * element_count, call_count, [this, other, relocate_fn] {
+            relocate_fn(vars.data(), other);
+            relocate_fn(other, vars.data());
+        });
+        alloc.deallocate(other, element_count);
+        return ns;
+    }
+
+    std::vector<Var_T> vars;
+};
+
+void run_relocation() {
+    using idym_var_t = idym::variant<std::unique_ptr<int>, int>;
+    using std_var_t = std::variant<std::unique_ptr<int>, int>;
+    relocation_bench<idym_var_t> idym_bench;
+    relocation_bench<std_var_t> std_bench;
+    const std::string config = "unique_ptr<int>, int";
+
+    const auto idym_relocate = [](idym_var_t* source, idym_var_t* dest) { idym::relocate_n(source, element_count, dest); };
+    // what std::vector growth does, a move construction and a destruction per element
+    const auto std_relocate = [](std_var_t* source, std_var_t* dest) {
+        for (std::size_t i = 0; i < element_count; ++i) {
+            ::new (static_cast<void*>(dest + i)) std_var_t(std::move(source[i]));
+            source[i].~std_var_t();
+        }
+    };
+    idym_bench::print_row("swap", config, idym_bench.swap(), std_bench.swap());
+    idym_bench::print_row("relocate_n", config, idym_bench.relocate(idym_relocate), std_bench.relocate(std_relocate));
+}
+
+// === mixed triviality, mostly trivial alternatives sharing a variant with std::string
+template<typename Var_T>
+struct mixed_bench {
+    mixed_bench() {
+        idym_bench::lcg rng{42};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            const auto roll = rng() % 100;
+            if (roll < 5)
+                source.emplace_back(std::string(32, 'x'));
+            else if (roll < 50)
+                source.emplace_back(static_cast<double>(i));
+            else
+                source.emplace_back(static_cast<int>(i));
+        }
+        dest = source;
+    }
+
+    double copy_ctor() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            for (const auto& v : source) {
+                Var_T copy{v};
+                idym_bench::do_not_optimize(copy);
+            }
+        });
+    }
+    double copy_assign() {
+        return idym_bench::measure(element_count, call_count, [this] {
+            for (std::size_t i = 0; i < element_count; ++i)
+                dest[i] = source[element_count - 1 - i];
+        });
+    }
+
+    std::vector<Var_T> source;
+    std::vector<Var_T> dest;
+};
+
+void run_mixed_triviality() {
+    mixed_bench<idym::variant<int, double, std::string>> idym_bench;
+    mixed_bench<std::variant<int, double, std::string>> std_bench;
+    const std::string config = "int, double, string 5%";
+
+    idym_bench::print_row("copy_ctor", config, idym_bench.copy_ctor(), std_bench.copy_ctor());
+    idym_bench::print_row("copy_assign", config, idym_bench.copy_assign(), std_bench.copy_assign());
+}
+
+int main(int, char**) {
+    idym_bench::print_header("config", "idym [ns/op]", "std [ns/op]");
+
+    run_config<2, 8>();
+    run_config<2, 64>();
+    run_config<8, 8>();
+    run_config<8, 64>();
+    run_config<32, 8>();
+    run_config<32, 64>();
+    run_config<64, 8>();
+    run_config<64, 64>();
+
+    std::printf("\n");
+    idym_bench::print_header("config", "visit_range [ns/op]", "visit [ns/op]");
+    run_range_config<2, 8>();
+    run_range_config<8, 8>();
+    run_range_config<32, 8>();
+    run_range_config<64, 64>();
+
+    std::printf("\n");
+    idym_bench::print_header("config", "visit_likely [ns/op]", "visit [ns/op]");
+    run_skewed_config<3, 99>();
+    run_skewed_config<3, 90>();
+    run_skewed_config<3, 50>();
+    run_skewed_config<32, 99>();
+    run_skewed_config<32, 90>();
+    run_skewed_config<32, 50>();
+
+    std::printf("\n");
+    idym_bench::print_header("config", "variant_vector [ns/op]", "vector [ns/op]");
+    run_partitioned_config<1>();
+    run_partitioned_config<10>();
+    run_partitioned_config<50>();
+
+    std::printf("\n");
+    idym_bench::print_header("config", "capped_variant [ns/op]", "variant [ns/op]");
+    run_boxed_config<1>();
+    run_boxed_config<10>();
+
+    std::printf("\n");
+    idym_bench::print_header("config", "idym [ns/op]", "std [ns/op]");
+    run_relocation();
+    run_mixed_triviality();
+}
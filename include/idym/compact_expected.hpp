@@ -0,0 +1,249 @@
+#ifndef IDYM_COMPACT_EXPECTED_H
+#define IDYM_COMPACT_EXPECTED_H
+
+#include "expected.hpp"
+
+namespace IDYM_NAMESPACE {
+
+template<typename T, typename E, E SuccessValue>
+class compact_expected;
+
+#ifdef IDYM_INSTRUMENT
+template<typename T, typename E, E SuccessValue>
+struct instrument_slots<compact_expected<T, E, SuccessValue>> : ::std::integral_constant<::std::size_t, 2> {};
+#endif
+
+/*
+ * expected<void, E> stored as a single E, SuccessValue is reserved to mean "has value".
+ * An error equal to SuccessValue reads back as a value, constructing one is a precondition violation
+ */
+template<typename E, E SuccessValue>
+class compact_expected<void, E, SuccessValue> {
+    static_assert(::std::is_trivially_copyable<E>::value, "E is required to be trivially copyable");
+
+public:
+    using value_type = void;
+    using error_type = E;
+    using unexpected_type = unexpected<E>;
+
+    template<typename U>
+    using rebind = ::std::conditional_t<::std::is_void<U>::value, compact_expected, expected<U, error_type>>;
+
+    // === ctors
+    constexpr compact_expected() noexcept : _unex{SuccessValue} {}
+    constexpr explicit compact_expected(in_place_t) noexcept : _unex{SuccessValue} {}
+
+    template<
+        typename G,
+        ::std::enable_if_t<!::std::is_convertible<const G&, E>::value && ::std::is_constructible<E, const G&>::value, bool> = true
+    >
+    constexpr explicit compact_expected(const expected<void, G>& other) : _unex(other.has_value() ? SuccessValue : E(other.error())) {}
+    template<
+        typename G,
+        ::std::enable_if_t<::std::is_convertible<const G&, E>::value && ::std::is_constructible<E, const G&>::value, bool> = true
+    >
+    constexpr compact_expected(const expected<void, G>& other) : _unex(other.has_value() ? SuccessValue : E(other.error())) {}
+
+    template<
+        typename G,
+        ::std::enable_if_t<!::std::is_convertible<const G&, E>::value && ::std::is_constructible<E, const G&>::value, bool> = true
+    >
+    constexpr explicit compact_expected(const unexpected<G>& e) : _unex(e.error()) {}
+    template<
+        typename G,
+        ::std::enable_if_t<::std::is_convertible<const G&, E>::value && ::std::is_constructible<E, const G&>::value, bool> = true
+    >
+    constexpr compact_expected(const unexpected<G>& e) : _unex(e.error()) {}
+
+    template<
+        typename... Args,
+        ::std::enable_if_t<::std::is_constructible<E, Args...>::value, bool> = true
+    >
+    constexpr explicit compact_expected(unexpect_t, Args&&... args) : _unex(::std::forward<Args>(args)...) {}
+
+    // === assignment
+    template<typename G, ::std::enable_if_t<::std::is_assignable<E&, const G&>::value, bool> = true>
+    constexpr compact_expected& operator=(const unexpected<G>& e) {
+        _unex = e.error();
+        return *this;
+    }
+
+    constexpr void emplace() noexcept {
+        _unex = SuccessValue;
+    }
+
+    // === swap
+    constexpr void swap(compact_expected& rhs) noexcept {
+        const E tmp = _unex;
+        _unex = rhs._unex;
+        rhs._unex = tmp;
+    }
+    friend constexpr void swap(compact_expected& x, compact_expected& y) noexcept {
+        x.swap(y);
+    }
+
+    // === conversion to the non-compact form
+    constexpr operator expected<void, E>() const {
+        return has_value() ? expected<void, E>() : expected<void, E>(unexpect, _unex);
+    }
+
+    // === observers
+    constexpr explicit operator bool() const noexcept {
+        return has_value();
+    }
+    constexpr bool has_value() const noexcept {
+        return _unex == SuccessValue;
+    }
+
+    constexpr void operator*() const noexcept {}
+
+    constexpr void value() const {
+        IDYM_INTERNAL_INSTRUMENT(compact_expected, value, has_value() ? 0 : 1);
+        if (!has_value()) {
+            IDYM_INTERNAL_INSTRUMENT(compact_expected, bad_access, 1);
+            IDYM_INTERNAL_THROW(bad_expected_access<E>(_unex));
+        }
+    }
+
+    constexpr const E& error() const & noexcept {
+        return _unex;
+    }
+    constexpr E& error() & noexcept {
+        return _unex;
+    }
+    constexpr E&& error() && noexcept {
+        return ::std::move(_unex);
+    }
+    constexpr const E&& error() const && noexcept {
+        return ::std::move(_unex);
+    }
+
+    template<typename G = E>
+    constexpr E error_or(G&& e) const {
+        if (has_value())
+            return ::std::forward<G>(e);
+        return _unex;
+    }
+
+    // === monads, E is trivially copyable so value categories of the error don't matter past or_else
+    template<typename F>
+    constexpr auto and_then(F&& f) const {
+        using U = remove_cvref_t<invoke_result_t<F>>;
+        static_assert(::std::is_same<typename U::error_type, E>::value, "F has to return an expected with the same error type");
+
+        if (has_value())
+            return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f));
+        return U(unexpect, _unex);
+    }
+
+    template<typename F>
+    constexpr auto or_else(F&& f) & {
+        return or_else_impl<E&>(::std::forward<F>(f), _unex);
+    }
+    template<typename F>
+    constexpr auto or_else(F&& f) const & {
+        return or_else_impl<const E&>(::std::forward<F>(f), _unex);
+    }
+    template<typename F>
+    constexpr auto or_else(F&& f) && {
+        return or_else_impl<E&&>(::std::forward<F>(f), ::std::move(_unex));
+    }
+    template<typename F>
+    constexpr auto or_else(F&& f) const && {
+        return or_else_impl<const E&&>(::std::forward<F>(f), ::std::move(_unex));
+    }
+
+    template<typename F>
+    constexpr auto transform(F&& f) const {
+        using U = ::std::remove_cv_t<invoke_result_t<F>>;
+        return transform_impl<U>(::std::is_void<U>{}, ::std::forward<F>(f));
+    }
+
+    template<typename F>
+    constexpr auto transform_error(F&& f) const {
+        using G = ::std::remove_cv_t<invoke_result_t<F, const E&>>;
+        if (has_value())
+            return expected<void, G>();
+        return expected<void, G>(unexpect, ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), _unex));
+    }
+
+    // === comparators
+    template<typename E2, E2 SuccessValue2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator==(const compact_expected& x, const compact_expected<void, E2, SuccessValue2>& y) {
+        if (x.has_value() != y.has_value())
+            return false;
+        return x.has_value() || static_cast<bool>(x.error() == y.error());
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator==(const compact_expected& x, const expected<void, E2>& y) {
+        if (x.has_value() != y.has_value())
+            return false;
+        return x.has_value() || static_cast<bool>(x.error() == y.error());
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator==(const compact_expected& x, const unexpected<E2>& e) {
+        return !x.has_value() && static_cast<bool>(x.error() == e.error());
+    }
+
+#if __cpp_impl_three_way_comparison < 201907L
+    // suppliment for synthesized ops
+    template<typename E2, E2 SuccessValue2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator!=(const compact_expected& x, const compact_expected<void, E2, SuccessValue2>& y) {
+        return !(x == y);
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator!=(const compact_expected& x, const expected<void, E2>& y) {
+        return !(x == y);
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator!=(const expected<void, E2>& y, const compact_expected& x) {
+        return !(x == y);
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator==(const expected<void, E2>& y, const compact_expected& x) {
+        return x == y;
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator!=(const compact_expected& x, const unexpected<E2>& e) {
+        return !(x == e);
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator!=(const unexpected<E2>& e, const compact_expected& x) {
+        return !(x == e);
+    }
+    template<typename E2, ::std::enable_if_t<_internal::expected_eq_test<const E&, const E2&>::value, bool> = true>
+    friend constexpr bool operator==(const unexpected<E2>& e, const compact_expected& x) {
+        return x == e;
+    }
+#endif
+
+private:
+    template<typename Err_T, typename F, typename Unex_T>
+    constexpr auto or_else_impl(F&& f, Unex_T&& unex) const {
+        using G = remove_cvref_t<invoke_result_t<F, Err_T>>;
+        static_assert(::std::is_void<typename G::value_type>::value, "F has to return an expected with a void value type");
+
+        if (has_value())
+            return G();
+        return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), ::std::forward<Unex_T>(unex));
+    }
+
+    template<typename U, typename F>
+    constexpr compact_expected transform_impl(::std::true_type, F&& f) const {
+        if (has_value())
+            ::IDYM_NAMESPACE::invoke(::std::forward<F>(f));
+        return *this;
+    }
+    template<typename U, typename F>
+    constexpr expected<U, E> transform_impl(::std::false_type, F&& f) const {
+        if (has_value())
+            return expected<U, E>(in_place, ::IDYM_NAMESPACE::invoke(::std::forward<F>(f)));
+        return expected<U, E>(unexpect, _unex);
+    }
+
+    E _unex;
+};
+
+}
+
+#endif
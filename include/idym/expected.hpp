@@ -1,10 +1,13 @@
 #ifndef IDYM_EXPECTED_H
 #define IDYM_EXPECTED_H
 
+#include <cstring>
 #include <exception>
 #include <initializer_list>
 
 #include "utility.hpp"
+#include "memory.hpp"
+#include "functional.hpp"
 #include "type_traits.hpp"
 
 namespace IDYM_NAMESPACE {
@@ -132,6 +135,38 @@ struct unexpect_t {
 };
 IDYM_INTERNAL_CXX17_INLINE constexpr unexpect_t unexpect{};
 
+// === expected_niche
+/*
+ * Opt-in customization point, declares a bit pattern T never holds. expected<T, E> marks its error state
+ * with it instead of keeping a separate flag when E fits below the pattern and T is nothrow move constructible.
+ * A specialization with available = true provides:
+ *  offset - first byte of the pattern within T, E has to fit in the bytes before it
+ *  size - length of the pattern, it has to end within T
+ *  set(void*) - writes the pattern into storage holding no T
+ *  test(const void*) - checks the storage for the pattern
+ */
+template<typename T>
+struct expected_niche {
+    static constexpr bool available = false;
+};
+
+// niche of fixed bytes written at Offset
+template<::std::size_t Offset, unsigned char... Pattern>
+struct expected_pattern_niche {
+    static constexpr bool available = true;
+    static constexpr ::std::size_t offset = Offset;
+    static constexpr ::std::size_t size = sizeof...(Pattern);
+
+    static void set(void* storage) noexcept {
+        const unsigned char pattern[] = {Pattern...};
+        ::std::memcpy(static_cast<unsigned char*>(storage) + Offset, pattern, sizeof(pattern));
+    }
+    static bool test(const void* storage) noexcept {
+        const unsigned char pattern[] = {Pattern...};
+        return ::std::memcmp(static_cast<const unsigned char*>(storage) + Offset, pattern, sizeof(pattern)) == 0;
+    }
+};
+
 namespace _internal { // >>> internal
 
 // msvc 19.16 can't expand the template pack in void_or_traits, needs to happen in a separate template below
@@ -162,37 +197,99 @@ union empty_union {
 template<typename T>
 using expected_value_member_t = ::std::conditional_t<::std::is_void<T>::value, empty_union, T>;
 
-// === expected_base
+// === expected_flag
+template<typename T, typename E, typename = void>
+struct expected_niche_usable : ::std::false_type {};
+
+// the niche has to clear the error, which lives at the start of the storage, and survive failed reinitialization
+template<typename T, typename E>
+struct expected_niche_usable<T, E, ::std::enable_if_t<expected_niche<T>::available>> : ::std::integral_constant<bool,
+    sizeof(E) <= expected_niche<T>::offset && ::std::is_nothrow_move_constructible<T>::value
+> {};
+
+// === expected_storage
 template<bool, typename, typename>
-struct expected_base_impl;
+struct expected_storage;
 
 template<typename T, typename E>
-struct expected_base_impl<true, T, E> {
+struct expected_storage<true, T, E> {
     union {
         expected_value_member_t<T> _val;
         E _unex;
         union {} _dummy;
     };
-    bool _has_val;
-    
-    constexpr expected_base_impl() noexcept(::std::is_void<T>::value) : _dummy{} {}
+
+    constexpr expected_storage() noexcept(::std::is_void<T>::value) : _dummy{} {}
 };
 template<typename T, typename E>
-struct expected_base_impl<false, T, E> {
+struct expected_storage<false, T, E> {
     union {
         expected_value_member_t<T> _val;
         E _unex;
         union {} _dummy;
     };
+
+    constexpr expected_storage() noexcept(::std::is_void<T>::value) : _dummy{} {}
+    // the active member is destroyed by expected_base_impl, which knows the state
+    IDYM_INTERNAL_CXX20_CONSTEXPR_DTOR ~expected_storage() {}
+};
+
+// the flag follows the storage, as a member would
+template<typename Storage_T, typename T, typename E, bool = expected_niche_usable<T, E>::value>
+struct expected_flag : Storage_T {
     bool _has_val;
 
-    constexpr expected_base_impl() noexcept(::std::is_void<T>::value) : _dummy{} {}
+    template<typename Val_T>
+    constexpr bool get_has_val(const Val_T&) const noexcept {
+        return _has_val;
+    }
+    template<typename Val_T>
+    constexpr void put_has_val(Val_T&, bool has_val) noexcept {
+        _has_val = has_val;
+    }
+};
+// no flag, the error state is marked by writing the niche over the unused value bytes
+template<typename Storage_T, typename T, typename E>
+struct expected_flag<Storage_T, T, E, true> : Storage_T {
+    static_assert(expected_niche<T>::offset + expected_niche<T>::size <= sizeof(T), "the niche of T is required to lie within T");
+
+    static bool get_has_val(const T& storage) noexcept {
+        return !expected_niche<T>::test(::std::addressof(storage));
+    }
+    static void put_has_val(T& storage, bool has_val) noexcept {
+        if (!has_val)
+            expected_niche<T>::set(::std::addressof(storage));
+    }
+};
+
+// === expected_base
+template<bool, typename, typename>
+struct expected_base_impl;
+
+template<typename T, typename E>
+struct expected_base_impl<true, T, E> : expected_flag<expected_storage<true, T, E>, T, E> {
+    constexpr bool has_val() const noexcept {
+        return this->get_has_val(this->_val);
+    }
+    constexpr void set_has_val(bool has_val) noexcept {
+        this->put_has_val(this->_val, has_val);
+    }
+};
+template<typename T, typename E>
+struct expected_base_impl<false, T, E> : expected_flag<expected_storage<false, T, E>, T, E> {
     IDYM_INTERNAL_CXX20_CONSTEXPR_DTOR ~expected_base_impl() {
         using TT = expected_value_member_t<T>;
-        if (_has_val)
-            _val.~TT();
+        if (has_val())
+            this->_val.~TT();
         else
-            _unex.~E();
+            this->_unex.~E();
+    }
+
+    constexpr bool has_val() const noexcept {
+        return this->get_has_val(this->_val);
+    }
+    constexpr void set_has_val(bool has_val) noexcept {
+        this->put_has_val(this->_val, has_val);
     }
 };
 
@@ -210,6 +307,11 @@ constexpr void reinit_expected_dispatch_nothrow_move_cons(::std::true_type, T& n
 }
 template<typename T, typename U, typename... Args>
 IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void reinit_expected_dispatch_nothrow_move_cons(::std::false_type, T& newval, U& oldval, Args&&... args) {
+#ifdef IDYM_NO_EXCEPTIONS
+    // construction can't fail, no backup needed
+    oldval.~U();
+    ::new (::std::addressof(newval)) expected_value_member_t<T>(::std::forward<Args>(args)...);
+#else
     U tmp(::std::move(oldval));
     oldval.~U();
 
@@ -219,6 +321,7 @@ IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void reinit_expected_dispatch_nothrow_mov
         ::new (::std::addressof(oldval)) U(::std::move(tmp));
         throw;
     }
+#endif
 }
 
 template<typename T, typename U, typename... Args>
@@ -290,16 +393,30 @@ struct expected_movecopy_base : expected_nmove_ass_base<T, E> {
 template<typename T, typename E>
 struct expected_copy_ctor_base_impl : expected_movecopy_base<T, E> {
     constexpr expected_copy_ctor_base_impl() noexcept(::std::is_void<T>::value) = default;
+    // only one of the states has to be copied through its constructor, a bytewise copyable one is copied as bytes
     constexpr expected_copy_ctor_base_impl(const expected_copy_ctor_base_impl& other) {
-        if (other._has_val)
-            ::new (::std::addressof(this->_val)) expected_value_member_t<T>(other._val);
-        else
-            ::new (::std::addressof(this->_unex)) E(other._unex);
-        this->_has_val = other._has_val;
+        if (other.has_val()) {
+            if (!IDYM_INTERNAL_CONSTANT_EVALUATED() && is_bytewise_copyable<expected_value_member_t<T>>::value)
+                copy_bytes(this->_val, other._val);
+            else
+                ::new (::std::addressof(this->_val)) expected_value_member_t<T>(other._val);
+        } else {
+            if (!IDYM_INTERNAL_CONSTANT_EVALUATED() && is_bytewise_copyable<E>::value)
+                copy_bytes(this->_unex, other._unex);
+            else
+                ::new (::std::addressof(this->_unex)) E(other._unex);
+        }
+        this->set_has_val(other.has_val());
     }
 
     constexpr expected_copy_ctor_base_impl& operator=(const expected_copy_ctor_base_impl&) = default;
     constexpr expected_copy_ctor_base_impl& operator=(expected_copy_ctor_base_impl&&) noexcept(expected_move_ass_noexcept_v<T, E>) = default;
+
+private:
+    template<typename U>
+    static void copy_bytes(U& dest, const U& src) noexcept {
+        ::std::memcpy(static_cast<void*>(::std::addressof(dest)), static_cast<const void*>(::std::addressof(src)), sizeof(U));
+    }
 };
 template<typename T, typename E>
 using expected_copy_ctor_base = ::std::conditional_t<
@@ -314,11 +431,11 @@ struct expected_move_ctor_base_impl : expected_copy_ctor_base<T, E> {
     constexpr expected_move_ctor_base_impl() noexcept(::std::is_void<T>::value) = default;
     constexpr expected_move_ctor_base_impl(const expected_move_ctor_base_impl&) = default;
     constexpr expected_move_ctor_base_impl(expected_move_ctor_base_impl&& other) noexcept(expected_move_ctor_noexcept_v<T, E>) {
-        if (other._has_val)
+        if (other.has_val())
             ::new (::std::addressof(this->_val)) expected_value_member_t<T>(::std::move(other._val));
         else
             ::new (::std::addressof(this->_unex)) E(::std::move(other._unex));
-        this->_has_val = other._has_val;
+        this->set_has_val(other.has_val());
     }
     
     constexpr expected_move_ctor_base_impl& operator=(const expected_move_ctor_base_impl&) = default;
@@ -340,16 +457,16 @@ struct expected_move_ass_base_impl : expected_move_ctor_base<T, E> {
     
     constexpr expected_move_ass_base_impl& operator=(const expected_move_ass_base_impl&) = default;
     constexpr expected_move_ass_base_impl& operator=(expected_move_ass_base_impl&& other) noexcept(expected_move_ass_noexcept_v<T, E>) {
-        if (this->_has_val && other._has_val)
+        if (this->has_val() && other.has_val())
             this->_val = ::std::move(other._val);
-        else if (this->_has_val)
+        else if (this->has_val())
             reinit_expected(this->_unex, this->_val, ::std::move(other._unex));
-        else if (other._has_val)
+        else if (other.has_val())
             reinit_expected(this->_val, this->_unex, ::std::move(other._val));
         else
             this->_unex = ::std::move(other._unex);
         
-        this->_has_val = other._has_val;
+        this->set_has_val(other.has_val());
         return *this;
     }
 };
@@ -365,18 +482,48 @@ struct expected_copy_ass_base_impl : expected_move_ass_base<T, E> {
 
     constexpr expected_copy_ass_base_impl& operator=(expected_copy_ass_base_impl&&) noexcept(expected_move_ass_noexcept_v<T, E>) = default;
     constexpr expected_copy_ass_base_impl& operator=(const expected_copy_ass_base_impl& other) {
-        if (this->_has_val && other._has_val)
+        if (this->has_val() && other.has_val())
             this->_val = other._val;
-        else if (this->_has_val)
-            reinit_expected(this->_unex, this->_val, other._unex);
-        else if (other._has_val)
-            reinit_expected(this->_val, this->_unex, other._val);
+        else if (this->has_val())
+            reinit_state(this->_unex, this->_val, other._unex);
+        else if (other.has_val())
+            reinit_state(this->_val, this->_unex, other._val);
         else
             this->_unex = other._unex;
         
-        this->_has_val = other._has_val;
+        this->set_has_val(other.has_val());
         return *this;
     }
+
+private:
+    // a bytewise copyable old state is backed up by its bytes, the copy is then made in place instead of in a temporary
+    template<typename New_T, typename Old_T>
+    constexpr void reinit_state(New_T& newval, Old_T& oldval, const New_T& v) {
+        if (!IDYM_INTERNAL_CONSTANT_EVALUATED() && is_bytewise_copyable<Old_T>::value && !::std::is_nothrow_copy_constructible<New_T>::value)
+            reinit_state_bytewise(newval, oldval, v);
+        else
+            reinit_expected(newval, oldval, v);
+    }
+    template<typename New_T, typename Old_T>
+    void reinit_state_bytewise(New_T& newval, Old_T& oldval, const New_T& v) {
+#ifdef IDYM_NO_EXCEPTIONS
+        oldval.~Old_T();
+        ::new (::std::addressof(newval)) New_T(v);
+#else
+        const bool had_val = this->has_val();
+        unsigned char backup[sizeof(Old_T)];
+        ::std::memcpy(backup, static_cast<const void*>(::std::addressof(oldval)), sizeof(Old_T));
+
+        try {
+            ::new (::std::addressof(newval)) New_T(v);
+        } catch (...) {
+            // the failed construction may have written over a niche past the old state
+            ::std::memcpy(static_cast<void*>(::std::addressof(oldval)), backup, sizeof(Old_T));
+            this->set_has_val(had_val);
+            throw;
+        }
+#endif
+    }
 };
 template<typename T, typename E>
 using expected_copy_ass_base = ::std::conditional_t<expected_ncopy_ass_defined_v<T, E>, expected_copy_ass_base_impl<T, E>, expected_move_ass_base<T, E>>;
@@ -389,7 +536,7 @@ template<typename T, typename E>
 struct expected_def_ctor_base_impl<true, T, E> : expected_copy_ass_base<T, E> {
     constexpr expected_def_ctor_base_impl() noexcept(::std::is_void<T>::value) {
         ::new (::std::addressof(this->_val)) expected_value_member_t<T>();
-        this->_has_val = true;
+        this->set_has_val(true);
     }
     constexpr expected_def_ctor_base_impl(dummy_t) {}
 };
@@ -465,6 +612,11 @@ IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void swap_expected(::std::true_type, expe
     E tmp(::std::move(rhs._unex));
     rhs._unex.~E();
 
+#ifdef IDYM_NO_EXCEPTIONS
+    ::new (::std::addressof(rhs._val)) expected_value_member_t<T>(::std::move(this_ref._val));
+    this_ref._val.~TT();
+    ::new (::std::addressof(this_ref._unex)) E(::std::move(tmp));
+#else
     try {
         ::new (::std::addressof(rhs._val)) expected_value_member_t<T>(::std::move(this_ref._val));
         this_ref._val.~TT();
@@ -473,6 +625,7 @@ IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void swap_expected(::std::true_type, expe
         ::new (::std::addressof(rhs._unex)) E(::std::move(tmp));
         throw;
     }
+#endif
 }
 template<bool Trivial, typename T, typename E>
 IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void swap_expected(::std::false_type, expected_base_impl<Trivial, T, E>& this_ref, expected_base_impl<Trivial, T, E>& rhs) {
@@ -480,6 +633,11 @@ IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void swap_expected(::std::false_type, exp
     expected_value_member_t<T> tmp(::std::move(this_ref._val));
     this_ref._val.~TT();
 
+#ifdef IDYM_NO_EXCEPTIONS
+    ::new (::std::addressof(this_ref._unex)) E(::std::move(rhs._unex));
+    rhs._unex.~E();
+    ::new (::std::addressof(rhs._val)) expected_value_member_t<T>(::std::move(tmp));
+#else
     try {
         ::new (::std::addressof(this_ref._unex)) E(::std::move(rhs._unex));
         rhs._unex.~E();
@@ -488,6 +646,7 @@ IDYM_INTERNAL_CXX20_CONSTEXPR_TRYCATCH void swap_expected(::std::false_type, exp
         ::new (::std::addressof(this_ref._val)) expected_value_member_t<T>(::std::move(tmp));
         throw;
     }
+#endif
 }
 
 template<bool, typename T, typename E>
@@ -502,29 +661,43 @@ struct swappable_base_impl<true, T, E> : expected_def_ctor_base<T, E> {
     constexpr void swap(expected<T, E>& rhs) noexcept(expected_swap_noexcept_v<T, E>) {
         auto& this_expected = static_cast<expected<T, E>&>(*this);
 
-        if (rhs._has_val && this_expected._has_val) {
+        if (rhs.has_val() && this_expected.has_val()) {
             using ::std::swap;
             swap(this_expected._val, rhs._val);
             return;
         }
-        if (rhs._has_val && !this_expected._has_val) {
+        if (rhs.has_val() && !this_expected.has_val()) {
             rhs.swap(this_expected);
             return;
         }
-        if (!rhs._has_val && !this_expected._has_val) {
+        if (!rhs.has_val() && !this_expected.has_val()) {
             using ::std::swap;
             swap(this_expected._unex, rhs._unex);
             return;
         }
 
-        swap_expected(::std::integral_constant<bool, ::std::is_nothrow_move_constructible<E>::value>{}, this_expected, rhs);
-        this_expected._has_val = false;
-        rhs._has_val = true;
+        swap_states(relocation_kind<expected<T, E>>{}, this_expected, rhs);
     }
 
     friend constexpr void swap(expected<T, E>& x, expected<T, E>& y) noexcept(expected_swap_noexcept_v<T, E>) {
         x.swap(y);
     }
+
+private:
+    // this holds a value and rhs an error, the objects are exchanged whole when T and E allow it
+    static constexpr void swap_states(::std::integral_constant<int, 0>, expected<T, E>& this_expected, expected<T, E>& rhs) {
+        const expected<T, E> tmp{this_expected};
+        this_expected = rhs;
+        rhs = tmp;
+    }
+    static constexpr void swap_states(::std::integral_constant<int, 1>, expected<T, E>& this_expected, expected<T, E>& rhs) {
+        swap_object_representations(this_expected, rhs);
+    }
+    static constexpr void swap_states(::std::integral_constant<int, 2>, expected<T, E>& this_expected, expected<T, E>& rhs) {
+        swap_expected(::std::integral_constant<bool, ::std::is_nothrow_move_constructible<E>::value>{}, this_expected, rhs);
+        this_expected.set_has_val(false);
+        rhs.set_has_val(true);
+    }
 };
 
 template<typename T, typename E>
@@ -542,11 +715,11 @@ constexpr auto make_monad_value_ret(::std::false_type, Value_T&& value) {
 
 template<typename F, typename Value_T>
 constexpr auto make_monad_invoke_ret(::std::true_type, F&& f, Value_T&&) {
-    return invoke(::std::forward<F>(f));
+    return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f));
 }
 template<typename F, typename Value_T>
 constexpr auto make_monad_invoke_ret(::std::false_type, F&& f, Value_T&& value) {
-    return invoke(::std::forward<F>(f), ::std::forward<Value_T>(value));
+    return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), ::std::forward<Value_T>(value));
 }
 
 template<typename F, typename T, typename = void>
@@ -708,10 +881,10 @@ public:
     
     // === observers
     constexpr explicit operator bool() const noexcept {
-        return this->_has_val;
+        return this->has_val();
     }
     constexpr bool has_value() const noexcept {
-        return this->_has_val;
+        return this->has_val();
     }
 
     constexpr const E& error() const & noexcept {
@@ -730,13 +903,13 @@ public:
 
     template<typename G = E>
     constexpr E error_or(G&& e) const & {
-        if (this->_has_val)
+        if (this->has_val())
             return ::std::forward<G>(e);
         return this->error();
     }
     template<typename G = E>
     constexpr E error_or(G&& e) && {
-        if (this->_has_val)
+        if (this->has_val())
             return ::std::forward<G>(e);
         return ::std::move(this->error());
     }
@@ -744,54 +917,54 @@ public:
     // === monads
     template<typename F, _internal::expected_monad_constraint_t<F, E, E&> = true>
     constexpr auto and_then(F&& f) & {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_invoke_ret(::std::is_void<T>{}, ::std::forward<F>(f), this->_val);
         return expected_invoke_result_t<F, decltype(this->_val)>(unexpect, this->error());
     }
     template<typename F, _internal::expected_monad_constraint_t<F, E, const E&> = true>
     constexpr auto and_then(F&& f) const & {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_invoke_ret(::std::is_void<T>{}, ::std::forward<F>(f), this->_val);
         return expected_invoke_result_t<F, decltype(this->_val)>(unexpect, this->error());
     }
 
     template<typename F, _internal::expected_monad_constraint_t<F, E, E&&> = true>
     constexpr auto and_then(F&& f) && {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_invoke_ret(::std::is_void<T>{}, ::std::forward<F>(f), ::std::move(this->_val));
         return expected_invoke_result_t<F, decltype(::std::move(this->_val))>(unexpect, ::std::move(this->error()));
     }
     template<typename F, _internal::expected_monad_constraint_t<F, E, const E&&> = true>
     constexpr auto and_then(F&& f) const && {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_invoke_ret(::std::is_void<T>{}, ::std::forward<F>(f), ::std::move(this->_val));
         return expected_invoke_result_t<F, decltype(::std::move(this->_val))>(unexpect, ::std::move(this->error()));
     }
 
     template<typename F, _internal::expected_monad_constraint_t<F, T, ::std::add_lvalue_reference_t<T>> = true>
     constexpr auto or_else(F&& f) & {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_value_ret<remove_cvref_t<invoke_result_t<F, decltype(this->error())>>>(::std::is_void<T>{}, this->_val);
-        return invoke(::std::forward<F>(f), this->_unex);
+        return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), this->_unex);
     }
     template<typename F, _internal::expected_monad_constraint_t<F, T, ::std::add_lvalue_reference_t<const T>> = true>
     constexpr auto or_else(F&& f) const & {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_value_ret<remove_cvref_t<invoke_result_t<F, decltype(this->error())>>>(::std::is_void<T>{}, this->_val);
-        return invoke(::std::forward<F>(f), this->_unex);
+        return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), this->_unex);
     }
 
     template<typename F, _internal::expected_monad_constraint_t<F, T, ::std::add_rvalue_reference_t<T>> = true>
     constexpr auto or_else(F&& f) && {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_value_ret<remove_cvref_t<invoke_result_t<F, decltype(::std::move(this->error()))>>>(::std::is_void<T>{}, ::std::move(this->_val));
-        return invoke(::std::forward<F>(f), ::std::move(this->_unex));
+        return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), ::std::move(this->_unex));
     }
     template<typename F, _internal::expected_monad_constraint_t<F, T, ::std::add_rvalue_reference_t<const T>> = true>
     constexpr auto or_else(F&& f) const && {
-        if (this->_has_val)
+        if (this->has_val())
             return make_monad_value_ret<remove_cvref_t<invoke_result_t<F, decltype(::std::move(this->error()))>>>(::std::is_void<T>{}, ::std::move(this->_val));
-        return invoke(::std::forward<F>(f), ::std::move(this->_unex));
+        return ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), ::std::move(this->_unex));
     }
 
     template<typename F, _internal::expected_monad_constraint_t<F, E, E&> = true>
@@ -883,7 +1056,7 @@ private:
     template<typename... Us>
     constexpr void forward_construct_e(Us&&... us) {
         ::new (::std::addressof(this->_unex)) E(::std::forward<Us>(us)...);
-        this->_has_val = false;
+        this->set_has_val(false);
     }
 
     template<typename Expected_T>
@@ -901,7 +1074,7 @@ private:
             forward_construct_compat_expected_value(::std::is_void<T>{}, ::std::forward<Expected_T>(other));
         else
             ::new (::std::addressof(this->_unex)) E(::std::forward<Expected_T>(other).error());
-        this->_has_val = other.has_value();
+        this->set_has_val(other.has_value());
     }
 
     template<typename U, typename This_T, typename F>
@@ -917,7 +1090,7 @@ private:
     static constexpr auto transform_impl(This_T&& this_ref, F&& f) {
         using U = expected_invoke_result_t<F, decltype(::std::forward<This_T>(this_ref)._val)>;
     
-        if (!this_ref._has_val)
+        if (!this_ref.has_val())
             return expected<U, E>(unexpect, ::std::forward<This_T>(this_ref).error());
         return transform_impl<U>(::std::integral_constant<bool, ::std::is_void<U>::value>{}, ::std::forward<This_T>(this_ref), ::std::forward<F>(f));
     }
@@ -926,9 +1099,9 @@ private:
     static constexpr auto transform_error_impl(This_T&& this_ref, F&& f) {
         using G = ::std::remove_cv_t<invoke_result_t<F, decltype(::std::forward<This_T>(this_ref).error())>>;
     
-        if (this_ref._has_val)
+        if (this_ref.has_val())
             return make_monad_value_ret<expected<T, G>>(::std::is_void<T>{}, ::std::forward<This_T>(this_ref)._val);
-        return expected<T, G>(unexpect, invoke(::std::forward<F>(f), ::std::forward<This_T>(this_ref).error()));
+        return expected<T, G>(unexpect, ::IDYM_NAMESPACE::invoke(::std::forward<F>(f), ::std::forward<This_T>(this_ref).error()));
     }
 };
 
@@ -1000,11 +1173,11 @@ public:
         bool> = true
     >
     constexpr expected& operator=(U&& v) {
-        if (this->_has_val) {
+        if (this->has_val()) {
             this->_val = ::std::forward<U>(v);
         } else {
             _internal::reinit_expected(this->_val, this->_unex, ::std::forward<U>(v));
-            this->_has_val = true;
+            this->set_has_val(true);
         }
         return *this;
     }
@@ -1053,72 +1226,103 @@ public:
     }
 
     constexpr const T& value() const & {
-        if (this->_has_val)
+        IDYM_INTERNAL_INSTRUMENT(expected, value, this->has_val() ? 0 : 1);
+        if (this->has_val())
             return this->_val;
-        throw bad_expected_access<E>(as_const(this->_unex));
+        IDYM_INTERNAL_INSTRUMENT(expected, bad_access, 1);
+        IDYM_INTERNAL_THROW(bad_expected_access<E>(::IDYM_NAMESPACE::as_const(this->_unex)));
     }
     constexpr T& value() & {
-        if (this->_has_val)
+        IDYM_INTERNAL_INSTRUMENT(expected, value, this->has_val() ? 0 : 1);
+        if (this->has_val())
             return this->_val;
-        throw bad_expected_access<E>(as_const(this->_unex));
+        IDYM_INTERNAL_INSTRUMENT(expected, bad_access, 1);
+        IDYM_INTERNAL_THROW(bad_expected_access<E>(::IDYM_NAMESPACE::as_const(this->_unex)));
     }
 
     constexpr T&& value() && {
-        if (this->_has_val)
+        IDYM_INTERNAL_INSTRUMENT(expected, value, this->has_val() ? 0 : 1);
+        if (this->has_val())
             return ::std::move(this->_val);
-        throw bad_expected_access<E>(::std::move(this->_unex));
+        IDYM_INTERNAL_INSTRUMENT(expected, bad_access, 1);
+        IDYM_INTERNAL_THROW(bad_expected_access<E>(::std::move(this->_unex)));
     }
     constexpr const T&& value() const && {
-        if (this->_has_val)
+        IDYM_INTERNAL_INSTRUMENT(expected, value, this->has_val() ? 0 : 1);
+        if (this->has_val())
             return ::std::move(this->_val);
-        throw bad_expected_access<E>(::std::move(this->_unex));
+        IDYM_INTERNAL_INSTRUMENT(expected, bad_access, 1);
+        IDYM_INTERNAL_THROW(bad_expected_access<E>(::std::move(this->_unex)));
     }
 
     template<typename U = remove_cvref_t<T>>
     constexpr T value_or(U&& v) const & {
-        return this->_has_val ? **this : static_cast<T>(::std::forward<U>(v));
+        return this->has_val() ? **this : static_cast<T>(::std::forward<U>(v));
     }
     template<typename U = remove_cvref_t<T>>
     constexpr T value_or(U&& v)  && {
-        return this->_has_val ? ::std::move(**this) : static_cast<T>(::std::forward<U>(v));
+        return this->has_val() ? ::std::move(**this) : static_cast<T>(::std::forward<U>(v));
     }
     
     // === comparators
+    // the expected argument is deduced rather than converted to, otherwise checking T == T2 can pick these very overloads up
+    // through a conversion from T and recurse, e.g. comparing iterators of a std::vector<expected<T, E>>.
+    // The expected* parameter keeps the friend templates of different instantiations distinct, const expected* marks the reversed ones
     template<
+        typename Ex_T,
         typename T2,
         // gcc 6.3 may go into infinite recursion on expected_eq_test here, needs to be short-circuited by filtering expected instantiations out
         // msvc 19.16 then gets scared when the value is accessed within enable_if, introduce the conjunction Constraint first
         typename Constraint = conjunction<
+            ::std::is_same<Ex_T, expected>,
             negation<_internal::is_specialization_of<T2, ::IDYM_NAMESPACE::expected>>,
             _internal::expected_eq_test<const T&, const T2&>
         >,
-        ::std::enable_if_t<Constraint::value, bool> = true
+        ::std::enable_if_t<Constraint::value, expected*> = nullptr
     >
-    friend constexpr bool operator==(const expected& x, const T2& v) {
+    friend constexpr bool operator==(const Ex_T& x, const T2& v) {
         return x.has_value() && static_cast<bool>(*x == v);
     }
 
 #if __cpp_impl_three_way_comparison < 201907L
     // suppliment for synthesized ops
     template<
+        typename Ex_T,
         typename T2,
-        ::std::enable_if_t<!_internal::is_specialization_of_v<T2, ::IDYM_NAMESPACE::expected> && _internal::expected_eq_test<const T&, const T2&>::value, bool> = true
+        typename Constraint = conjunction<
+            ::std::is_same<Ex_T, expected>,
+            negation<_internal::is_specialization_of<T2, ::IDYM_NAMESPACE::expected>>,
+            _internal::expected_eq_test<const T&, const T2&>
+        >,
+        ::std::enable_if_t<Constraint::value, expected*> = nullptr
     >
-    friend constexpr bool operator!=(const expected& x, const T2& v) {
+    friend constexpr bool operator!=(const Ex_T& x, const T2& v) {
         return !(x == v);
     }
     template<
         typename T2,
-        ::std::enable_if_t<!_internal::is_specialization_of_v<T2, ::IDYM_NAMESPACE::expected> && _internal::expected_eq_test<const T&, const T2&>::value, bool> = true
-        >
-    friend constexpr bool operator!=(const T2& v, const expected& x) {
+        typename Ex_T,
+        typename Constraint = conjunction<
+            ::std::is_same<Ex_T, expected>,
+            negation<_internal::is_specialization_of<T2, ::IDYM_NAMESPACE::expected>>,
+            _internal::expected_eq_test<const T&, const T2&>
+        >,
+        ::std::enable_if_t<Constraint::value, const expected*> = nullptr
+    >
+    friend constexpr bool operator!=(const T2& v, const Ex_T& x) {
         return x != v;
     }
     template<
         typename T2,
-        ::std::enable_if_t<!_internal::is_specialization_of_v<T2, ::IDYM_NAMESPACE::expected> && _internal::expected_eq_test<const T&, const T2&>::value, bool> = true
+        typename Ex_T,
+        typename Constraint = conjunction<
+            ::std::is_same<Ex_T, expected>,
+            negation<_internal::is_specialization_of<T2, ::IDYM_NAMESPACE::expected>>,
+            _internal::expected_eq_test<const T&, const T2&>
+        >,
+        ::std::enable_if_t<Constraint::value, const expected*> = nullptr
     >
-    friend constexpr bool operator==(const T2& v, const expected& x) {
+    friend constexpr bool operator==(const T2& v, const Ex_T& x) {
         return x == v;
     }
 #endif
@@ -1129,14 +1333,14 @@ private:
     template<typename... Us>
     constexpr void forward_construct_t(Us&&... us) {
         ::new (::std::addressof(this->_val)) T(::std::forward<Us>(us)...);
-        this->_has_val = true;
+        this->set_has_val(true);
     }
 
     template<typename G>
     constexpr expected& forward_assign_e(G&& g) {
-        if (this->_has_val) {
+        if (this->has_val()) {
             _internal::reinit_expected(this->_unex, this->_val, ::std::forward<G>(g));
-            this->_has_val = false;
+            this->set_has_val(false);
         } else {
             this->_unex = ::std::forward<G>(g);
         }
@@ -1145,11 +1349,11 @@ private:
 
     template<typename... Ts>
     constexpr T& emplace_impl(Ts&&... args) noexcept {
-        if (this->_has_val) {
+        if (this->has_val()) {
             this->_val.~T();
         } else {
             this->_unex.~E();
-            this->_has_val = true;
+            this->set_has_val(true);
         }
 
         ::new (::std::addressof(this->_val)) T(::std::forward<Ts>(args)...);
@@ -1162,28 +1366,40 @@ namespace _internal { // >>> internal
 template<typename T, typename E>
 struct expected_void_toplevel_base : expected_toplevel_base<T, E> {
     using expected_toplevel_base<T, E>::expected_toplevel_base;
+    using expected_type = expected<T, E>;
     
     constexpr void emplace() noexcept {
-        if (!this->_has_val) {
+        if (!this->has_val()) {
             this->_unex.~E();
-            this->_has_val = true;
+            this->set_has_val(true);
         }
     }
     
     constexpr void operator*() const noexcept {}
 
     constexpr void value() const & {
-        if (!this->_has_val)
-            throw bad_expected_access<E>(this->_unex);
+        IDYM_INTERNAL_INSTRUMENT(expected_type, value, this->has_val() ? 0 : 1);
+        if (!this->has_val()) {
+            IDYM_INTERNAL_INSTRUMENT(expected_type, bad_access, 1);
+            IDYM_INTERNAL_THROW(bad_expected_access<E>(this->_unex));
+        }
     }
     constexpr void value() && {
-        if (!this->_has_val)
-            throw bad_expected_access<E>(::std::move(this->_unex));
+        IDYM_INTERNAL_INSTRUMENT(expected_type, value, this->has_val() ? 0 : 1);
+        if (!this->has_val()) {
+            IDYM_INTERNAL_INSTRUMENT(expected_type, bad_access, 1);
+            IDYM_INTERNAL_THROW(bad_expected_access<E>(::std::move(this->_unex)));
+        }
     }
 };
 
 } // <<< internal
 
+#ifdef IDYM_INSTRUMENT
+template<typename T, typename E>
+struct instrument_slots<expected<T, E>> : ::std::integral_constant<::std::size_t, 2> {};
+#endif
+
 // === expected<cv void, E>
 template<typename E>
 class expected<void, E> : public _internal::expected_void_toplevel_base<void, E> {
@@ -1206,8 +1422,59 @@ public:
     using _internal::expected_void_toplevel_base<const volatile void, E>::expected_void_toplevel_base;
 };
 
+// === is_trivially_relocatable, propagated from T and E
+template<typename T, typename E>
+struct is_trivially_relocatable<expected<T, E>> : conjunction<
+    disjunction<::std::is_void<T>, is_trivially_relocatable<::std::remove_cv_t<T>>>,
+    is_trivially_relocatable<E>
+> {};
+
+namespace _internal { // >>> internal
+
+// disabled specialization, neither constructible nor assignable
+template<typename, typename = void>
+struct expected_hash_base {
+    expected_hash_base() = delete;
+    expected_hash_base(const expected_hash_base&) = delete;
+    expected_hash_base& operator=(const expected_hash_base&) = delete;
+};
+
+template<typename T, typename E>
+struct expected_hash_base<
+    expected<T, E>,
+    ::std::enable_if_t<disjunction_v<::std::is_void<T>, hash_enabled<::std::remove_cv_t<T>>> && hash_enabled<::std::remove_cv_t<E>>::value>
+>
+{
+    // the has-value flag is mixed in, a value and an error hashing the same don't collide
+    constexpr ::std::size_t operator()(const expected<T, E>& ex) const {
+        if (ex.has_value())
+            return hash_mix(1, hash_value(::std::is_void<T>{}, ex));
+        return hash_mix(0, ::std::hash<::std::remove_cv_t<E>>{}(ex.error()));
+    }
+
+private:
+    static constexpr ::std::size_t hash_value(::std::true_type, const expected<T, E>&) {
+        return 0;
+    }
+    static constexpr ::std::size_t hash_value(::std::false_type, const expected<T, E>& ex) {
+        return ::std::hash<::std::remove_cv_t<T>>{}(*ex);
+    }
+};
+
+} // <<< internal
+
 }
 
+#ifndef IDYM_NOSTD_INTEROP
+namespace std { // >>> std
+
+// === hash
+template<typename T, typename E>
+struct hash<::IDYM_NAMESPACE::expected<T, E>> : ::IDYM_NAMESPACE::_internal::expected_hash_base<::IDYM_NAMESPACE::expected<T, E>> {};
+
+} // <<< std
+#endif
+
 #undef IDYM_COMPAT_EXPECTED_EXPLICIT_V
 #undef IDYM_COMPAT_EXPECTED_CONSTRAINT_V
 #undef IDYM_COMPAT_T_CONSTRAINT_V
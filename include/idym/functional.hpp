@@ -1,6 +1,44 @@
 #ifndef IDYM_FUNCTIONAL_H
 #define IDYM_FUNCTIONAL_H
 
+#include <cstdint>
+
 #include "type_traits.hpp"
 
+namespace IDYM_NAMESPACE {
+
+namespace _internal { // >>> internal
+
+// === hash_enabled, std::hash<T> is an enabled specialization
+template<typename T, typename = void>
+struct hash_enabled : ::std::false_type {};
+template<typename T>
+struct hash_enabled<T, ::std::enable_if_t<
+    ::std::is_default_constructible<::std::hash<T>>::value &&
+    ::std::is_copy_constructible<::std::hash<T>>::value &&
+    ::std::is_copy_assignable<::std::hash<T>>::value &&
+    ::std::is_destructible<::std::hash<T>>::value &&
+    is_swappable<::std::hash<T>>::value &&
+    ::std::is_same<::std::size_t, decltype(::std::hash<T>{}(::std::declval<const T&>()))>::value
+>> : ::std::true_type {};
+
+// === hash_mix
+/*
+ * Folds a discriminator into a hash, finished with the murmur3 64 bit finalizer.
+ * Identity hashes of small integers end up spread over all bits, tables with power of two sizes included
+ */
+constexpr ::std::size_t hash_mix(::std::size_t discriminator, ::std::size_t hash) noexcept {
+    ::std::uint64_t h = static_cast<::std::uint64_t>(hash) ^ (static_cast<::std::uint64_t>(discriminator) * 0x9e3779b97f4a7c15ull);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return static_cast<::std::size_t>(h);
+}
+
+} // <<< internal
+
+}
+
 #endif
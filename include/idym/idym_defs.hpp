@@ -1,10 +1,21 @@
 #ifndef IDYM_IDYM_DEFS_H
 #define IDYM_IDYM_DEFS_H
 
+#include <cassert>
+
 #ifndef IDYM_NAMESPACE
   #define IDYM_NAMESPACE idym
 #endif
 
+#if !defined(IDYM_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+  #define IDYM_NO_EXCEPTIONS
+#endif
+
+#ifdef IDYM_NO_EXCEPTIONS
+  #include <cstdlib>
+  #include <exception>
+#endif
+
 #if __cpp_inline_variables >= 201606L
   #define IDYM_INTERNAL_CXX17_INLINE inline
 #else
@@ -25,10 +36,77 @@
   #define IDYM_INTERNAL_CXX20_CONSTEXPR_DTOR
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+  #define IDYM_INTERNAL_LIKELY(COND) __builtin_expect(static_cast<bool>(COND), 1)
+#else
+  #define IDYM_INTERNAL_LIKELY(COND) static_cast<bool>(COND)
+#endif
+
 namespace IDYM_NAMESPACE {
 namespace _internal {
 struct dummy_t {};
 }
+
+#ifdef IDYM_NO_EXCEPTIONS
+// === throw_handler, receives what would have been thrown, the program aborts if it returns
+using throw_handler_t = void (*)(const ::std::exception&);
+
+namespace _internal { // >>> internal
+inline throw_handler_t& throw_handler_storage() noexcept {
+    static throw_handler_t handler = nullptr;
+    return handler;
+}
+
+[[noreturn]] inline void throw_exception(const ::std::exception& e) noexcept {
+    if (const throw_handler_t handler = throw_handler_storage())
+        handler(e);
+    ::std::abort();
+}
+} // <<< internal
+
+// not synchronized, meant to be installed once at startup
+inline throw_handler_t set_throw_handler(throw_handler_t handler) noexcept {
+    const throw_handler_t prev = _internal::throw_handler_storage();
+    _internal::throw_handler_storage() = handler;
+    return prev;
+}
+inline throw_handler_t get_throw_handler() noexcept {
+    return _internal::throw_handler_storage();
+}
+#endif
 }
 
+// precondition checks of the unchecked interfaces, gone with NDEBUG
+#define IDYM_INTERNAL_ASSERT(COND, MSG) assert((COND) && MSG)
+
+#ifdef IDYM_NO_EXCEPTIONS
+  #define IDYM_INTERNAL_THROW(...) ::IDYM_NAMESPACE::_internal::throw_exception(__VA_ARGS__)
+#else
+  #define IDYM_INTERNAL_THROW(...) throw __VA_ARGS__
+#endif
+
+// false where the compiler can't tell, runtime only paths are then not constant expressions
+#if defined(__has_builtin)
+  #if __has_builtin(__builtin_is_constant_evaluated)
+    #define IDYM_INTERNAL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+  #endif
+#endif
+#ifndef IDYM_INTERNAL_CONSTANT_EVALUATED
+  #define IDYM_INTERNAL_CONSTANT_EVALUATED() false
+#endif
+
+/*
+ * Event hooks reported to instrument.hpp, nothing is emitted unless IDYM_INSTRUMENT is defined.
+ * Constant evaluation skips them where the compiler can tell, elsewhere instrumented calls aren't constant expressions
+ */
+#ifdef IDYM_INSTRUMENT
+  #define IDYM_INTERNAL_INSTRUMENT(TYPE, EVENT, SLOT) \
+      (IDYM_INTERNAL_CONSTANT_EVALUATED() ? static_cast<void>(0) : \
+          ::IDYM_NAMESPACE::_internal::instrument_report<TYPE>(::IDYM_NAMESPACE::instrument_event::EVENT, SLOT))
+
+  #include "instrument.hpp"
+#else
+  #define IDYM_INTERNAL_INSTRUMENT(TYPE, EVENT, SLOT) static_cast<void>(0)
+#endif
+
 #endif
@@ -0,0 +1,101 @@
+#ifndef IDYM_INSTRUMENT_H
+#define IDYM_INSTRUMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "idym_defs.hpp"
+
+namespace IDYM_NAMESPACE {
+
+// === instrument_event
+enum class instrument_event : unsigned char {
+    visit,      // visit, visit_unchecked or a hit of visit_likely, the slot is the visited alternative
+    get,        // checked get, the slot is the held alternative
+    emplace,    // the slot is the new alternative
+    assign,     // copy or move assignment from another variant, the slot is the source alternative
+    value,      // value() of expected, slot 0 for a value and 1 for an error
+    bad_access  // bad_variant_access or bad_expected_access is about to be thrown, the slot is the held state
+};
+constexpr ::std::size_t instrument_event_count = 6;
+
+// === instrument_slots, states reported for T: the alternatives then valueless for variants, value and error for expecteds
+template<typename T>
+struct instrument_slots;
+
+// === instrument_sink, receives every event in place of the default counters
+using instrument_sink_t = void (*)(instrument_event event, const void* type_key, ::std::size_t slot);
+
+namespace _internal { // >>> internal
+inline instrument_sink_t& instrument_sink_storage() noexcept {
+    static instrument_sink_t sink = nullptr;
+    return sink;
+}
+} // <<< internal
+
+// not synchronized, meant to be installed once at startup
+inline instrument_sink_t set_instrument_sink(instrument_sink_t sink) noexcept {
+    const instrument_sink_t prev = _internal::instrument_sink_storage();
+    _internal::instrument_sink_storage() = sink;
+    return prev;
+}
+inline instrument_sink_t get_instrument_sink() noexcept {
+    return _internal::instrument_sink_storage();
+}
+
+// === instrument_counters
+/*
+ * Default sink, a relaxed atomic counter per event and slot of T.
+ * key() identifies T in the calls of a custom sink, slots past the last one are counted in it
+ */
+template<typename T>
+class instrument_counters {
+public:
+    static constexpr ::std::size_t slots = instrument_slots<T>::value;
+
+    static ::std::uint64_t count(instrument_event event, ::std::size_t slot) noexcept {
+        return storage()[counter_index(event, slot)].load(::std::memory_order_relaxed);
+    }
+    static void reset() noexcept {
+        for (auto& counter : storage())
+            counter.store(0, ::std::memory_order_relaxed);
+    }
+    static const void* key() noexcept {
+        return storage();
+    }
+
+    static constexpr ::std::size_t clamp_slot(::std::size_t slot) noexcept {
+        return slot < slots ? slot : slots - 1;
+    }
+    static void add(instrument_event event, ::std::size_t slot) noexcept {
+        storage()[counter_index(event, slot)].fetch_add(1, ::std::memory_order_relaxed);
+    }
+
+private:
+    using counters_t = ::std::atomic<::std::uint64_t>[instrument_event_count * slots];
+
+    static counters_t& storage() noexcept {
+        static counters_t counters{};
+        return counters;
+    }
+    static constexpr ::std::size_t counter_index(instrument_event event, ::std::size_t slot) noexcept {
+        return static_cast<::std::size_t>(event) * slots + clamp_slot(slot);
+    }
+};
+
+namespace _internal { // >>> internal
+
+template<typename T>
+void instrument_report(instrument_event event, ::std::size_t slot) noexcept {
+    if (const instrument_sink_t sink = instrument_sink_storage())
+        sink(event, instrument_counters<T>::key(), instrument_counters<T>::clamp_slot(slot));
+    else
+        instrument_counters<T>::add(event, slot);
+}
+
+} // <<< internal
+
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef IDYM_MEMORY_H
+#define IDYM_MEMORY_H
+
+#include <new>
+#include <memory>
+#include <cstring>
+
+#include "utility.hpp"
+#include "functional.hpp"
+#include "type_traits.hpp"
+
+namespace IDYM_NAMESPACE {
+
+// === is_trivially_relocatable
+/*
+ * Objects can be moved to a new address by copying their bytes, the source is then dead without running its destructor.
+ * Trivially copyable types are relocatable, other types opt in by specializing
+ */
+template<typename T>
+struct is_trivially_relocatable : ::std::is_trivially_copyable<T> {};
+
+template<typename T>
+struct is_trivially_relocatable<::std::unique_ptr<T>> : ::std::true_type {};
+
+// stateless
+template<typename T>
+struct is_trivially_relocatable<::std::allocator<T>> : ::std::true_type {};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace _internal { // >>> internal
+
+template<typename T>
+T* relocate_n_impl(::std::true_type, T* first, ::std::size_t count, T* dest) noexcept {
+    if (count != 0)
+        ::std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+    return dest + count;
+}
+template<typename T>
+T* relocate_n_impl(::std::false_type, T* first, ::std::size_t count, T* dest) noexcept {
+    for (::std::size_t i = 0; i < count; ++i) {
+        ::new (static_cast<void*>(dest + i)) T(::std::move(first[i]));
+        first[i].~T();
+    }
+    return dest + count;
+}
+
+// === relocation_kind, 0 - trivially copyable, 1 - trivially relocatable, 2 - move and destroy
+template<typename T>
+using relocation_kind = ::std::integral_constant<int,
+    ::std::is_trivially_copyable<T>::value ? 0 : (is_trivially_relocatable<T>::value ? 1 : 2)
+>;
+
+// === is_bytewise_copyable, copies of T can be made with memcpy, from lvalues and rvalues alike
+template<typename T>
+using is_bytewise_copyable = ::std::integral_constant<bool,
+    ::std::is_trivially_copyable<T>::value &&
+    ::std::is_trivially_copy_constructible<T>::value &&
+    ::std::is_trivially_move_constructible<T>::value
+>;
+
+// swaps two objects of a trivially relocatable type through a byte buffer
+template<typename T>
+void swap_object_representations(T& lhs, T& rhs) noexcept {
+    alignas(T) unsigned char tmp[sizeof(T)];
+    ::std::memcpy(tmp, static_cast<const void*>(::std::addressof(lhs)), sizeof(T));
+    ::std::memcpy(static_cast<void*>(::std::addressof(lhs)), static_cast<const void*>(::std::addressof(rhs)), sizeof(T));
+    ::std::memcpy(static_cast<void*>(::std::addressof(rhs)), tmp, sizeof(T));
+}
+
+} // <<< internal
+
+// === relocate_n
+/*
+ * Moves count objects from first to uninitialized dest and ends the lifetime of the sources, the ranges can't overlap.
+ * A single memcpy for trivially relocatable types, a move and destroy per object otherwise
+ */
+template<typename T>
+T* relocate_n(T* first, ::std::size_t count, T* dest) noexcept {
+    static_assert(
+        is_trivially_relocatable<T>::value || ::std::is_nothrow_move_constructible<T>::value,
+        "T is required to be trivially relocatable or nothrow move constructible"
+    );
+    return _internal::relocate_n_impl(is_trivially_relocatable<T>{}, first, count, dest);
+}
+
+// === relocate
+template<typename T>
+T* relocate(T* source, T* dest) noexcept {
+    relocate_n(source, 1, dest);
+    return dest;
+}
+
+namespace _internal { // >>> internal
+
+// the allocator is kept as a base, a stateless one takes no space
+template<typename Alloc_T>
+struct boxed_allocator_holder : Alloc_T {
+    explicit boxed_allocator_holder(const Alloc_T& alloc) noexcept : Alloc_T(alloc) {}
+
+    Alloc_T& allocator() noexcept {
+        return *this;
+    }
+    const Alloc_T& allocator() const noexcept {
+        return *this;
+    }
+};
+
+} // <<< internal
+
+// === boxed
+/*
+ * A T allocated through Alloc with value semantics, copies allocate a copy of the T and moves hand the allocation over.
+ * Meant as a variant alternative keeping a large type out of line: get<T>, get_if<T>, holds_alternative<T> and visit
+ * look through the box. A moved from box is empty, it can only be assigned to or destroyed: accessing its contents,
+ * directly or through a variant holding it, is a precondition violation checked in debug builds
+ */
+template<typename T, typename Alloc = ::std::allocator<T>>
+class boxed : _internal::boxed_allocator_holder<typename ::std::allocator_traits<Alloc>::template rebind_alloc<T>> {
+    using alloc_t = typename ::std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using alloc_traits = ::std::allocator_traits<alloc_t>;
+    using holder_t = _internal::boxed_allocator_holder<alloc_t>;
+    // move assignment can take the allocation over without comparing allocators
+    using move_hands_over = ::std::integral_constant<bool,
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value
+    >;
+
+    static_assert(::std::is_same<typename alloc_traits::pointer, T*>::value, "Alloc is required to allocate raw pointers");
+
+public:
+    using value_type = T;
+    using allocator_type = alloc_t;
+
+    // constructors without an allocator argument default construct one
+    template<typename U = T, ::std::enable_if_t<::std::is_default_constructible<U>::value && ::std::is_default_constructible<alloc_t>::value, bool> = true>
+    boxed() : boxed(::std::allocator_arg, alloc_t{}, in_place) {}
+    template<typename A = alloc_t, ::std::enable_if_t<::std::is_default_constructible<A>::value, bool> = true>
+    boxed(const T& v) : boxed(::std::allocator_arg, alloc_t{}, in_place, v) {}
+    template<typename A = alloc_t, ::std::enable_if_t<::std::is_default_constructible<A>::value, bool> = true>
+    boxed(T&& v) : boxed(::std::allocator_arg, alloc_t{}, in_place, ::std::move(v)) {}
+
+    template<typename... Args, typename A = alloc_t, ::std::enable_if_t<::std::is_default_constructible<A>::value, bool> = true>
+    explicit boxed(in_place_t, Args&&... args) : boxed(::std::allocator_arg, alloc_t{}, in_place, ::std::forward<Args>(args)...) {}
+    template<typename... Args>
+    boxed(::std::allocator_arg_t, const alloc_t& alloc, in_place_t, Args&&... args) : holder_t{alloc}, _ptr{nullptr} {
+        _ptr = allocate(::std::forward<Args>(args)...);
+    }
+
+    boxed(const boxed& other) :
+        holder_t{alloc_traits::select_on_container_copy_construction(other.allocator())}, _ptr{nullptr}
+    {
+        if (other._ptr)
+            _ptr = allocate(*other._ptr);
+    }
+    boxed(boxed&& other) noexcept : holder_t{other.allocator()}, _ptr{other._ptr} {
+        other._ptr = nullptr;
+    }
+
+    /*
+     * Assignments follow the allocator aware container rules, the allocator is replaced only when the propagate trait is set.
+     * Copies assign the contents in place when both boxes hold one and the allocation is kept.
+     * A move between unequal allocators that don't propagate moves the T itself into this allocator, the source is left empty
+     */
+    boxed& operator=(const boxed& other) {
+        if (this == &other)
+            return *this;
+        copy_assign_allocator(typename alloc_traits::propagate_on_container_copy_assignment{}, other);
+        if (_ptr && other._ptr)
+            *_ptr = *other._ptr;
+        else if (other._ptr)
+            _ptr = allocate(*other._ptr);
+        else
+            reset();
+        return *this;
+    }
+    boxed& operator=(boxed&& other) noexcept(move_hands_over::value) {
+        if (this != &other)
+            move_assign_impl(move_hands_over{}, other);
+        return *this;
+    }
+
+    ~boxed() {
+        reset();
+    }
+
+    T* get() noexcept {
+        return _ptr;
+    }
+    const T* get() const noexcept {
+        return _ptr;
+    }
+    T& operator*() noexcept {
+        IDYM_INTERNAL_ASSERT(_ptr, "Box can't be empty");
+        return *_ptr;
+    }
+    const T& operator*() const noexcept {
+        IDYM_INTERNAL_ASSERT(_ptr, "Box can't be empty");
+        return *_ptr;
+    }
+    T* operator->() noexcept {
+        IDYM_INTERNAL_ASSERT(_ptr, "Box can't be empty");
+        return _ptr;
+    }
+    const T* operator->() const noexcept {
+        IDYM_INTERNAL_ASSERT(_ptr, "Box can't be empty");
+        return _ptr;
+    }
+    explicit operator bool() const noexcept {
+        return _ptr != nullptr;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return this->allocator();
+    }
+
+    // allocators travel with their allocations
+    void swap(boxed& other) noexcept {
+        using ::std::swap;
+        swap(this->allocator(), other.allocator());
+        swap(_ptr, other._ptr);
+    }
+    friend void swap(boxed& lhs, boxed& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // contents are compared, neither box may be empty
+    template<typename U = T, typename = decltype(::std::declval<const U&>() == ::std::declval<const U&>())>
+    friend bool operator==(const boxed& lhs, const boxed& rhs) { return *lhs == *rhs; }
+    template<typename U = T, typename = decltype(::std::declval<const U&>() != ::std::declval<const U&>())>
+    friend bool operator!=(const boxed& lhs, const boxed& rhs) { return *lhs != *rhs; }
+    template<typename U = T, typename = decltype(::std::declval<const U&>() < ::std::declval<const U&>())>
+    friend bool operator<(const boxed& lhs, const boxed& rhs) { return *lhs < *rhs; }
+    template<typename U = T, typename = decltype(::std::declval<const U&>() > ::std::declval<const U&>())>
+    friend bool operator>(const boxed& lhs, const boxed& rhs) { return *lhs > *rhs; }
+    template<typename U = T, typename = decltype(::std::declval<const U&>() <= ::std::declval<const U&>())>
+    friend bool operator<=(const boxed& lhs, const boxed& rhs) { return *lhs <= *rhs; }
+    template<typename U = T, typename = decltype(::std::declval<const U&>() >= ::std::declval<const U&>())>
+    friend bool operator>=(const boxed& lhs, const boxed& rhs) { return *lhs >= *rhs; }
+
+private:
+    void reset() noexcept {
+        if (_ptr) {
+            alloc_traits::destroy(this->allocator(), _ptr);
+            alloc_traits::deallocate(this->allocator(), _ptr, 1);
+            _ptr = nullptr;
+        }
+    }
+
+    // contents allocated by an unequal allocator are released with it before it is replaced
+    void copy_assign_allocator(::std::true_type, const boxed& other) {
+        if (!alloc_traits::is_always_equal::value && this->allocator() != other.allocator())
+            reset();
+        this->allocator() = other.allocator();
+    }
+    void copy_assign_allocator(::std::false_type, const boxed&) noexcept {}
+
+    // the allocation is handed over
+    void move_assign_impl(::std::true_type, boxed& other) noexcept {
+        reset();
+        move_assign_allocator(typename alloc_traits::propagate_on_container_move_assignment{}, other);
+        _ptr = other._ptr;
+        other._ptr = nullptr;
+    }
+    void move_assign_impl(::std::false_type, boxed& other) {
+        if (this->allocator() == other.allocator())
+            return move_assign_impl(::std::true_type{}, other);
+        if (_ptr && other._ptr)
+            *_ptr = ::std::move(*other._ptr);
+        else if (other._ptr)
+            _ptr = allocate(::std::move(*other._ptr));
+        else
+            reset();
+        other.reset();
+    }
+
+    void move_assign_allocator(::std::true_type, boxed& other) noexcept {
+        this->allocator() = ::std::move(other.allocator());
+    }
+    void move_assign_allocator(::std::false_type, boxed&) noexcept {}
+
+    template<typename... Args>
+    T* allocate(Args&&... args) {
+        T* ptr = alloc_traits::allocate(this->allocator(), 1);
+#ifdef IDYM_NO_EXCEPTIONS
+        alloc_traits::construct(this->allocator(), ptr, ::std::forward<Args>(args)...);
+#else
+        try {
+            alloc_traits::construct(this->allocator(), ptr, ::std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(this->allocator(), ptr, 1);
+            throw;
+        }
+#endif
+        return ptr;
+    }
+
+    T* _ptr;
+};
+
+// a box is a pointer and its allocator
+template<typename T, typename Alloc>
+struct is_trivially_relocatable<boxed<T, Alloc>> : is_trivially_relocatable<typename ::std::allocator_traits<Alloc>::template rebind_alloc<T>> {};
+
+// === unboxed, the content type of a box, other types are left as they are
+template<typename T>
+struct unboxed {
+    using type = T;
+};
+template<typename T, typename Alloc>
+struct unboxed<boxed<T, Alloc>> {
+    using type = T;
+};
+template<typename T>
+using unboxed_t = typename unboxed<T>::type;
+
+// === boxed_if_larger_t, T boxed when it takes more than Max_Size bytes
+template<::std::size_t Max_Size, typename T, typename Alloc = ::std::allocator<T>>
+using boxed_if_larger_t = ::std::conditional_t<(sizeof(T) > Max_Size), boxed<T, Alloc>, T>;
+
+namespace _internal { // >>> internal
+
+template<typename T>
+struct is_boxed : ::std::false_type {};
+template<typename T, typename Alloc>
+struct is_boxed<boxed<T, Alloc>> : ::std::true_type {};
+
+// === unbox, references to boxes become references to their contents, anything else passes through
+template<typename T>
+constexpr T&& unbox(T&& v) noexcept {
+    return ::std::forward<T>(v);
+}
+template<typename T, typename Alloc>
+T& unbox(boxed<T, Alloc>& v) noexcept {
+    return *v;
+}
+template<typename T, typename Alloc>
+const T& unbox(const boxed<T, Alloc>& v) noexcept {
+    return *v;
+}
+template<typename T, typename Alloc>
+T&& unbox(boxed<T, Alloc>&& v) noexcept {
+    return ::std::move(*v);
+}
+template<typename T, typename Alloc>
+const T&& unbox(const boxed<T, Alloc>&& v) noexcept {
+    return ::std::move(*v);
+}
+
+template<typename T>
+constexpr T* unbox_ptr(T* ptr) noexcept {
+    return ptr;
+}
+template<typename T, typename Alloc>
+T* unbox_ptr(boxed<T, Alloc>* ptr) noexcept {
+    IDYM_INTERNAL_ASSERT(!ptr || *ptr, "Box can't be empty");
+    return ptr ? ptr->get() : nullptr;
+}
+template<typename T, typename Alloc>
+const T* unbox_ptr(const boxed<T, Alloc>* ptr) noexcept {
+    IDYM_INTERNAL_ASSERT(!ptr || *ptr, "Box can't be empty");
+    return ptr ? ptr->get() : nullptr;
+}
+
+// disabled specialization, neither constructible nor assignable
+template<typename, typename = void>
+struct boxed_hash_base {
+    boxed_hash_base() = delete;
+    boxed_hash_base(const boxed_hash_base&) = delete;
+    boxed_hash_base& operator=(const boxed_hash_base&) = delete;
+};
+
+// hashes the contents, a box hashes as the T it holds
+template<typename T, typename Alloc>
+struct boxed_hash_base<boxed<T, Alloc>, ::std::enable_if_t<hash_enabled<::std::remove_cv_t<T>>::value>> {
+    ::std::size_t operator()(const boxed<T, Alloc>& v) const {
+        return ::std::hash<::std::remove_cv_t<T>>{}(*v);
+    }
+};
+
+} // <<< internal
+
+}
+
+#ifndef IDYM_NOSTD_INTEROP
+namespace std { // >>> std
+
+template<typename T, typename Alloc>
+struct hash<::IDYM_NAMESPACE::boxed<T, Alloc>> : ::IDYM_NAMESPACE::_internal::boxed_hash_base<::IDYM_NAMESPACE::boxed<T, Alloc>> {};
+
+} // <<< std
+#endif
+
+#endif
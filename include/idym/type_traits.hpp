@@ -219,8 +219,8 @@ template<typename, typename, typename...>
 struct invoke_result {};
 
 template<typename F, typename... Args>
-struct invoke_result<void_t<decltype(invoke(::std::declval<F>(), ::std::declval<Args>()...))>, F, Args...> {
-    using type = decltype(invoke(::std::declval<F>(), ::std::declval<Args>()...));
+struct invoke_result<void_t<decltype(::IDYM_NAMESPACE::invoke(::std::declval<F>(), ::std::declval<Args>()...))>, F, Args...> {
+    using type = decltype(::IDYM_NAMESPACE::invoke(::std::declval<F>(), ::std::declval<Args>()...));
 };
 
 } // <<< internal
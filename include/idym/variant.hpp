@@ -1,9 +1,12 @@
 #ifndef IDYM_VARIANT_H
 #define IDYM_VARIANT_H
 
+#include <new>
 #include <array>
 #include <utility>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <functional>
 #include <initializer_list>
@@ -13,7 +16,9 @@
 #endif
 
 #include "type_traits.hpp"
+#include "functional.hpp"
 #include "utility.hpp"
+#include "memory.hpp"
 
 #if __cplusplus >= 202002L
   #define IDYM_INTERNAL_CXX20_DEPRECATED_VARIANT [[deprecated]]
@@ -21,10 +26,45 @@
   #define IDYM_INTERNAL_CXX20_DEPRECATED_VARIANT
 #endif
 
+#if defined(__has_builtin)
+  #if __has_builtin(__type_pack_element)
+    #define IDYM_INTERNAL_TYPE_PACK_ELEMENT
+  #endif
+  // pack lookups compare against every alternative, std::is_same would be a class instantiation per comparison
+  #if __has_builtin(__is_same)
+    #define IDYM_INTERNAL_IS_SAME(T, U) __is_same(T, U)
+  #endif
+#endif
+#ifndef IDYM_INTERNAL_IS_SAME
+  #define IDYM_INTERNAL_IS_SAME(T, U) ::std::is_same<T, U>::value
+#endif
+
+#if __cpp_lib_launder >= 201606L
+  #define IDYM_INTERNAL_LAUNDER(PTR) ::std::launder(PTR)
+#else
+  #define IDYM_INTERNAL_LAUNDER(PTR) (PTR)
+#endif
+
+// alternative count above which variants switch to the flat storage
+#ifndef IDYM_VARIANT_FLAT_STORAGE_THRESHOLD
+  #define IDYM_VARIANT_FLAT_STORAGE_THRESHOLD 32
+#endif
+
 namespace IDYM_NAMESPACE {
 
-template<typename...>
-class variant;
+template<bool, typename...>
+class basic_variant;
+
+template<typename... Ts>
+using variant = basic_variant<false, Ts...>;
+
+// a valid alternative is kept through throwing assignments and emplaces, see the notes on assign_never_valueless
+template<typename... Ts>
+using never_valueless_variant = basic_variant<true, Ts...>;
+
+// alternatives larger than Max_Size bytes are boxed, which caps the storage at Max_Size or a pointer
+template<::std::size_t Max_Size, typename... Ts>
+using capped_variant = variant<boxed_if_larger_t<Max_Size, Ts>...>;
 
 // === variant_npos
 IDYM_INTERNAL_CXX17_INLINE constexpr ::std::size_t variant_npos = -1;
@@ -61,12 +101,88 @@ struct first_of {
 template<typename... Ts>
 using first_of_t = typename first_of<Ts...>::type;
 
+// === pack lookups
+/*
+ * Constant instantiation depth in the pack size, every type lookup below instantiates a fixed number of templates
+ * instead of one per alternative it walks past
+ */
+constexpr ::std::size_t count_matches(::std::initializer_list<bool> matches) noexcept {
+    ::std::size_t count = 0;
+    for (const bool match : matches)
+        count += match;
+    return count;
+}
+constexpr ::std::size_t first_match(::std::initializer_list<bool> matches, ::std::size_t offset = 0) noexcept {
+    for (const bool match : matches) {
+        if (match)
+            return offset;
+        ++offset;
+    }
+    return variant_npos;
+}
+
+template<::std::size_t I, typename T>
+struct indexed_type {
+    using type = T;
+};
+template<typename, typename...>
+struct indexed_types;
+template<::std::size_t... Is, typename... Ts>
+struct indexed_types<::std::index_sequence<Is...>, Ts...> : indexed_type<Is, Ts>... {};
+
+template<typename... Ts>
+using indexed_types_ptr = const indexed_types<::std::index_sequence_for<Ts...>, Ts...>*;
+
+// picks the only base with index I, the rest don't deduce
+template<::std::size_t I, typename T>
+indexed_type<I, T> select_indexed(const indexed_type<I, T>*);
+
+// index of T if it occurs exactly once, more than one base with T is a deduction failure
+template<typename T, ::std::size_t I>
+::std::integral_constant<::std::size_t, I> unique_index_of(const indexed_type<I, T>*);
+template<typename T>
+::std::integral_constant<::std::size_t, variant_npos> unique_index_of(...);
+
+template<typename T, typename... Ts>
+using unique_index_t = decltype(unique_index_of<T>(static_cast<indexed_types_ptr<Ts...>>(nullptr)));
+
+// === index_to_alternative
+template<bool, ::std::size_t I, typename... Ts>
+struct index_to_alternative_impl {};
+
+template<::std::size_t I, typename... Ts>
+struct index_to_alternative_impl<true, I, Ts...> {
+#ifdef IDYM_INTERNAL_TYPE_PACK_ELEMENT
+    using type = __type_pack_element<I, Ts...>;
+#else
+    using type = typename decltype(select_indexed<I>(static_cast<indexed_types_ptr<Ts...>>(nullptr)))::type;
+#endif
+};
+
+// no type for I out of range
+template<::std::size_t I, typename... Ts>
+struct index_to_alternative : index_to_alternative_impl<(I < sizeof...(Ts)), I, Ts...> {};
+
+template<::std::size_t I, typename... Ts>
+using index_to_alternative_t = typename index_to_alternative<I, Ts...>::type;
+
+// === variant_index_t
+// smallest unsigned type fitting every alternative index, its max value is left free for the valueless state
+template<::std::size_t Size>
+using variant_index_t = ::std::conditional_t<
+    (Size < static_cast<unsigned char>(-1)), unsigned char,
+    ::std::conditional_t<(Size < static_cast<unsigned short>(-1)), unsigned short, ::std::size_t>
+>;
+
+template<::std::size_t Size>
+IDYM_INTERNAL_CXX17_INLINE constexpr variant_index_t<Size> variant_index_npos = static_cast<variant_index_t<Size>>(-1);
+
 // === variant_storage
 template<bool, typename... Ts>
 union variant_storage_impl;
 
 template<typename... Ts>
-using variant_storage = variant_storage_impl<conjunction_v<::std::is_trivially_destructible<Ts>...>, Ts...>;
+using variant_union_storage = variant_storage_impl<conjunction_v<::std::is_trivially_destructible<Ts>...>, Ts...>;
 
 template<bool Trivial_Dtor> union variant_storage_impl<Trivial_Dtor> {};
 
@@ -75,7 +191,7 @@ union variant_storage_impl<true, T, Ts...> {
     static constexpr ::std::size_t size = sizeof...(Ts) + 1;
 
     T v0;
-    variant_storage<Ts...> v1;
+    variant_union_storage<Ts...> v1;
     
     constexpr variant_storage_impl() noexcept : v1{} {}
 };
@@ -85,12 +201,65 @@ union variant_storage_impl<false, T, Ts...> {
     static constexpr ::std::size_t size = sizeof...(Ts) + 1;
 
     T v0;
-    variant_storage<Ts...> v1;
+    variant_union_storage<Ts...> v1;
     
     constexpr variant_storage_impl() noexcept : v1{} {}
     IDYM_INTERNAL_CXX20_CONSTEXPR_DTOR ~variant_storage_impl() {}
 };
 
+// === variant_storage_flat
+/*
+ * Single aligned buffer all alternatives are placed in, any alternative is reached in O(1)
+ * instead of recursing through the nested unions above.
+ * Can't be used in constant expressions, the union storage is kept for smaller packs
+ */
+template<::std::size_t N>
+constexpr ::std::size_t pack_max(const ::std::size_t (&values)[N]) {
+    ::std::size_t ret = 0;
+    for (auto value : values)
+        ret = value > ret ? value : ret;
+    return ret;
+}
+
+template<typename... Ts>
+struct variant_storage_flat {
+    static constexpr ::std::size_t size = sizeof...(Ts);
+
+    alignas(pack_max({alignof(Ts)...})) unsigned char buffer[pack_max({sizeof(Ts)...})];
+};
+
+template<typename... Ts>
+using variant_storage = ::std::conditional_t<
+    (sizeof...(Ts) > IDYM_VARIANT_FLAT_STORAGE_THRESHOLD),
+    variant_storage_flat<Ts...>,
+    variant_union_storage<Ts...>
+>;
+
+// === variant_storage_double
+/*
+ * Never valueless variants with an alternative that may throw on move keep a spare buffer,
+ * new alternatives are built there and the buffers are flipped once that succeeded
+ */
+template<typename Storage_T>
+struct variant_storage_double {
+    static constexpr ::std::size_t size = Storage_T::size;
+
+    Storage_T buffers[2];
+    unsigned char active = 0;
+};
+
+template<typename>
+struct is_double_storage : ::std::false_type {};
+template<typename Storage_T>
+struct is_double_storage<variant_storage_double<Storage_T>> : ::std::true_type {};
+
+template<bool Never_Valueless, typename... Ts>
+using variant_storage_select = ::std::conditional_t<
+    Never_Valueless && !conjunction_v<::std::is_nothrow_move_constructible<Ts>...>,
+    variant_storage_double<variant_storage<Ts...>>,
+    variant_storage<Ts...>
+>;
+
 // === internal get
 template<typename Lhs_T, typename Rhs_T>
 struct ddispatch_var_pair {
@@ -113,23 +282,24 @@ constexpr auto make_ddispatch_pair(Lhs_T&& lhs, Rhs_T&& rhs) {
     return ddispatch_var_pair<decltype(::std::forward<Lhs_T>(lhs)), decltype(::std::forward<Rhs_T>(rhs))>{::std::forward<Lhs_T>(lhs), ::std::forward<Rhs_T>(rhs)};
 }
 
+// union storage, recurses down to the alternative
 template<::std::size_t I>
-struct get_variant_storage {
+struct get_union_storage {
     template<typename Storage_T>
     static constexpr auto do_get(Storage_T&& storage) {
-        return get_variant_storage<I - 1>::do_get(storage.v1);
+        return get_union_storage<I - 1>::do_get(storage.v1);
     }
     template<typename Storage_T>
     static constexpr decltype(auto) do_get_ref(Storage_T&& storage) {
-        return get_variant_storage<I - 1>::do_get_ref(storage.v1);
+        return get_union_storage<I - 1>::do_get_ref(storage.v1);
     }
     template<typename Lhs_T, typename Rhs_T>
     static constexpr decltype(auto) do_get_ref(ddispatch_var_pair<Lhs_T, Rhs_T>&& storage_pair) {
-        return get_variant_storage<I - 1>::do_get_ref(make_ddispatch_pair(::std::forward<Lhs_T>(storage_pair.lhs).v1, ::std::forward<Rhs_T>(storage_pair.rhs).v1));
+        return get_union_storage<I - 1>::do_get_ref(make_ddispatch_pair(::std::forward<Lhs_T>(storage_pair.lhs).v1, ::std::forward<Rhs_T>(storage_pair.rhs).v1));
     }
 };
 template<>
-struct get_variant_storage<0> {
+struct get_union_storage<0> {
     template<typename Storage_T>
     static constexpr auto do_get(Storage_T&& storage) {
         return &storage.v0;
@@ -144,121 +314,174 @@ struct get_variant_storage<0> {
     }
 };
 
-// === visitor
-// msvc 19.16 gets confused on pack expansion in functions below, this struct breaks it down
-template<::std::size_t... Is>
-struct partial_index_sequence {
-    template<::std::size_t I>
-    using type = ::std::index_sequence<Is..., I>;
+template<::std::size_t I>
+struct get_variant_storage;
+
+// double storage, forwards to the active buffer
+template<::std::size_t I>
+struct get_double_storage {
+    template<typename Storage_T>
+    static constexpr auto do_get(Storage_T&& storage) {
+        return get_variant_storage<I>::do_get(storage.buffers[storage.active]);
+    }
+    template<typename Storage_T>
+    static constexpr decltype(auto) do_get_ref(Storage_T&& storage) {
+        return get_variant_storage<I>::do_get_ref(::std::forward<Storage_T>(storage).buffers[storage.active]);
+    }
+    template<typename Lhs_T, typename Rhs_T>
+    static constexpr decltype(auto) do_get_ref(ddispatch_var_pair<Lhs_T, Rhs_T>&& storage_pair) {
+        return get_variant_storage<I>::do_get_ref(make_ddispatch_pair(
+            ::std::forward<Lhs_T>(storage_pair.lhs).buffers[storage_pair.lhs.active],
+            ::std::forward<Rhs_T>(storage_pair.rhs).buffers[storage_pair.rhs.active]
+        ));
+    }
+};
+
+// flat storage, casts the buffer directly
+template<::std::size_t I, typename... Ts>
+struct get_flat_storage {
+    template<typename Storage_T>
+    static auto do_get(Storage_T&& storage) {
+        using alt_t = ::std::conditional_t<
+            ::std::is_const<::std::remove_reference_t<Storage_T>>::value,
+            const index_to_alternative_t<I, Ts...>,
+            index_to_alternative_t<I, Ts...>
+        >;
+        return IDYM_INTERNAL_LAUNDER(reinterpret_cast<alt_t*>(storage.buffer));
+    }
+    template<typename Storage_T>
+    static decltype(auto) do_get_ref(Storage_T&& storage) {
+        using alt_ref_t = ::std::conditional_t<
+            ::std::is_lvalue_reference<Storage_T>::value,
+            decltype(*do_get(storage))&,
+            decltype(*do_get(storage))&&
+        >;
+        return static_cast<alt_ref_t>(*do_get(storage));
+    }
+    template<typename Lhs_T, typename Rhs_T>
+    static decltype(auto) do_get_ref(ddispatch_var_pair<Lhs_T, Rhs_T>&& storage_pair) {
+        return make_ddispatch_pair(do_get_ref(::std::forward<Lhs_T>(storage_pair.lhs)), do_get_ref(::std::forward<Rhs_T>(storage_pair.rhs)));
+    }
+};
+
+template<::std::size_t I, typename Storage_T>
+struct variant_storage_access {
+    using type = get_union_storage<I>;
+};
+template<::std::size_t I, typename... Ts>
+struct variant_storage_access<I, variant_storage_flat<Ts...>> {
+    using type = get_flat_storage<I, Ts...>;
+};
+template<::std::size_t I, typename Storage_T>
+struct variant_storage_access<I, variant_storage_double<Storage_T>> {
+    using type = get_double_storage<I>;
+};
+template<::std::size_t I, typename Lhs_T, typename Rhs_T>
+struct variant_storage_access<I, ddispatch_var_pair<Lhs_T, Rhs_T>> : variant_storage_access<I, remove_cvref_t<Lhs_T>> {};
+
+template<::std::size_t I>
+struct get_variant_storage {
+    template<typename Storage_T>
+    static constexpr auto do_get(Storage_T&& storage) {
+        return variant_storage_access<I, remove_cvref_t<Storage_T>>::type::do_get(::std::forward<Storage_T>(storage));
+    }
+    template<typename Storage_T>
+    static constexpr decltype(auto) do_get_ref(Storage_T&& storage) {
+        return variant_storage_access<I, remove_cvref_t<Storage_T>>::type::do_get_ref(::std::forward<Storage_T>(storage));
+    }
 };
 
+// === visitor
 template<typename Ret_T, typename Is_Sequence_T, typename Visitor_T, typename... Storage_Ts>
 struct dispatch_variant_storage;
 
 template<typename Ret_T, ::std::size_t... Is, typename Visitor_T, typename... Storage_Ts>
 struct dispatch_variant_storage<Ret_T, ::std::index_sequence<Is...>, Visitor_T, Storage_Ts...> {
     static constexpr Ret_T do_dispatch(Visitor_T visitor, Storage_Ts... vs) {
-        return invoke(::std::forward<Visitor_T>(visitor), get_variant_storage<Is>::do_get_ref(::std::forward<decltype(vs)>(vs))...);
+        return ::IDYM_NAMESPACE::invoke(::std::forward<Visitor_T>(visitor), get_variant_storage<Is>::do_get_ref(::std::forward<decltype(vs)>(vs))...);
     }
 };
 
-template<typename Ret_T, typename Visitor_T, typename... Storage_Ts, ::std::size_t... Is, ::std::size_t... Sequence_Is>
-constexpr auto make_dispatch_table(::std::index_sequence<Is...>, ::std::index_sequence<Sequence_Is...>) {
-    using dispatch_t = dispatch_variant_storage<Ret_T, ::std::index_sequence<Sequence_Is..., 0>, Visitor_T, Storage_Ts...>;
-    using partial_seq_t = partial_index_sequence<Sequence_Is...>;
-
-    return ::std::array<
-        decltype(dispatch_t::do_dispatch)*, sizeof...(Is)
-    >{dispatch_variant_storage<Ret_T, typename partial_seq_t::template type<Is>, Visitor_T, Storage_Ts...>::do_dispatch...};
-}
-
 template<typename Alt_Indices, typename Src_Type>
 struct alt_visitor_arg {};
 
 template<typename... Args>
 struct alt_visitor_accumulator {};
 
-template<typename Ret_t, typename Accumulator_T, typename Is_Sequence, typename Visitor_T, typename... Storage_Ts>
-struct alt_visitor_table;
+/*
+ * Multi-variant dispatch, the alternative indices are treated as digits of a mixed radix number,
+ * the first variant being the most significant one. All combinations live in a single flat table
+ */
+template<::std::size_t... Sizes>
+struct flat_dispatch_radix {
+    static constexpr ::std::size_t size() {
+        const ::std::size_t sizes[] = {Sizes...};
+        ::std::size_t ret = 1;
+        for (auto size : sizes)
+            ret *= size;
+        return ret;
+    }
+    static constexpr ::std::size_t digit(::std::size_t flat_index, ::std::size_t digit_index) {
+        const ::std::size_t sizes[] = {Sizes...};
+        for (::std::size_t i = sizeof...(Sizes) - 1; i > digit_index; --i)
+            flat_index /= sizes[i];
+        return flat_index % sizes[digit_index];
+    }
+    static constexpr ::std::size_t flatten(const ::std::array<::std::size_t, sizeof...(Sizes)>& indices) {
+        const ::std::size_t sizes[] = {Sizes...};
+        ::std::size_t ret = 0;
+        for (::std::size_t i = 0; i < sizeof...(Sizes); ++i)
+            ret = ret * sizes[i] + indices[i];
+        return ret;
+    }
+};
 
-template<
-    typename Ret_T,
-    typename... Acc_Ts,
-    ::std::size_t... Is_Sequence,
-    typename Visitor_T,
-    ::std::size_t... Alt_Indices, typename Src_T,
-    typename... Storage_Ts
->
-struct alt_visitor_table<
-    Ret_T,
-    alt_visitor_accumulator<Acc_Ts...>,
-    ::std::index_sequence<Is_Sequence...>,
-    Visitor_T,
-    alt_visitor_arg<::std::index_sequence<Alt_Indices...>, Src_T>,
-    Storage_Ts...
->
-{
-    using next_dispatch_t = alt_visitor_table<
-        Ret_T,
-        alt_visitor_accumulator<Acc_Ts..., Src_T>,
-        ::std::index_sequence<Is_Sequence..., 0>,
-        Visitor_T,
-        Storage_Ts...
-    >;
-    using next_dispatch_table_t = decltype(next_dispatch_t::dispatch_table);
-    using partial_seq_t = partial_index_sequence<Is_Sequence...>;
+template<typename Ret_T, typename Radix_T, typename Visitor_T, typename... Storage_Ts>
+struct flat_visitor_table {
+    template<::std::size_t Flat_I, ::std::size_t... Digits>
+    static constexpr auto make_entry(::std::index_sequence<Digits...>) {
+        return &dispatch_variant_storage<
+            Ret_T, ::std::index_sequence<Radix_T::digit(Flat_I, Digits)...>, Visitor_T, Storage_Ts...
+        >::do_dispatch;
+    }
+    template<::std::size_t... Flat_Is>
+    static constexpr auto make_table(::std::index_sequence<Flat_Is...>) {
+        using digits_t = ::std::make_index_sequence<sizeof...(Storage_Ts)>;
+        return ::std::array<decltype(make_entry<0>(digits_t{})), sizeof...(Flat_Is)>{make_entry<Flat_Is>(digits_t{})...};
+    }
 
-    static constexpr ::std::array<next_dispatch_table_t, sizeof...(Alt_Indices)> dispatch_table{
-        alt_visitor_table<
-            Ret_T,
-            alt_visitor_accumulator<Acc_Ts..., Src_T>,
-            typename partial_seq_t::template type<Alt_Indices>,
-            Visitor_T,
-            Storage_Ts...
-        >::dispatch_table...
-    };
+    using table_t = decltype(make_table(::std::make_index_sequence<Radix_T::size()>{}));
+    static constexpr table_t dispatch_table = make_table(::std::make_index_sequence<Radix_T::size()>{});
 };
+#if __cpp_inline_variables < 201606L
+template<typename Ret_T, typename Radix_T, typename Visitor_T, typename... Storage_Ts>
+constexpr typename flat_visitor_table<Ret_T, Radix_T, Visitor_T, Storage_Ts...>::table_t flat_visitor_table<Ret_T, Radix_T, Visitor_T, Storage_Ts...>::dispatch_table;
+#endif
 
-template<
-    typename Ret_T,
-    typename... Acc_Ts,
-    ::std::size_t... Is_Sequence,
-    typename Visitor_T,
-    ::std::size_t... Alt_Indices, typename Src_T
->
-struct alt_visitor_table<
-    Ret_T,
-    alt_visitor_accumulator<Acc_Ts...>,
-    ::std::index_sequence<Is_Sequence...>,
-    Visitor_T,
-    alt_visitor_arg<::std::index_sequence<Alt_Indices...>, Src_T>
->
-{
-    static constexpr auto dispatch_table = make_dispatch_table<Ret_T, Visitor_T, Acc_Ts..., Src_T>(::std::index_sequence<Alt_Indices...>{}, ::std::index_sequence<Is_Sequence...>{});
+/*
+ * Runtime indexed tables are read in place from static storage, one copy per instantiation.
+ * A function local constexpr array is materialized on the stack on every call at -O0, and by some compilers at any level
+ */
+template<typename Ptr_T, Ptr_T... Entries>
+struct static_dispatch_table {
+    static constexpr Ptr_T table[] = {Entries...};
 };
-
-template<::std::size_t N, ::std::size_t I, typename Dispatch_Table_T>
-constexpr auto find_dispatch_entry(::std::integral_constant<::std::size_t, I>, const ::std::array<::std::size_t, N>& indices, const Dispatch_Table_T& dispatch_table) {
-    return find_dispatch_entry(::std::integral_constant<::std::size_t, I + 1>{}, indices, dispatch_table[indices[I]]);
-}
-template<::std::size_t N, typename Dispatch_Table_T>
-constexpr auto find_dispatch_entry(::std::integral_constant<::std::size_t, N>, const ::std::array<::std::size_t, N>& indices, const Dispatch_Table_T& dispatch_table) {
-    return dispatch_table;
-}
+#if __cpp_inline_variables < 201606L
+template<typename Ptr_T, Ptr_T... Entries>
+constexpr Ptr_T static_dispatch_table<Ptr_T, Entries...>::table[];
+#endif
 
 template<typename Ret_T = void, typename Visitor_T, ::std::size_t N, typename... Storage_Ts>
 constexpr decltype(auto) visit_impl(Visitor_T&& visitor, const ::std::array<::std::size_t, N>& indices, Storage_Ts&&... vs) {
-    using dispatcher_t = alt_visitor_table<
+    using radix_t = flat_dispatch_radix<var_size<remove_cvref_t<Storage_Ts>>::size...>;
+    using dispatcher_t = flat_visitor_table<
         Ret_T,
-        alt_visitor_accumulator<>,
-        ::std::index_sequence<>,
+        radix_t,
         decltype(::std::forward<Visitor_T>(visitor)),
-        alt_visitor_arg<::std::make_index_sequence<var_size<remove_cvref_t<Storage_Ts>>::size>, decltype(::std::forward<Storage_Ts>(vs))>...
+        decltype(::std::forward<Storage_Ts>(vs))...
     >;
     
-    constexpr auto dispatch_table = dispatcher_t::dispatch_table;
-    const auto dispatch_fun = find_dispatch_entry(::std::integral_constant<::std::size_t, 0>{}, indices, dispatch_table);
-    return dispatch_fun(::std::forward<Visitor_T>(visitor), ::std::forward<Storage_Ts>(vs)...);
+    return dispatcher_t::dispatch_table[radix_t::flatten(indices)](::std::forward<Visitor_T>(visitor), ::std::forward<Storage_Ts>(vs)...);
 }
 
 template<typename Ret_T = void, typename Visitor_T, typename Storage_T>
@@ -267,8 +490,7 @@ constexpr decltype(auto) visit_impl(Visitor_T&& visitor, ::std::size_t index, St
 }
 template<typename Ret_T = void, typename Visitor_T, typename Storage_T1, typename Storage_T2>
 constexpr decltype(auto) visit_impl(Visitor_T&& visitor, ::std::size_t index, Storage_T1&& v1, Storage_T2&& v2) {
-    const ::std::array<::std::size_t, 1> indices{index};
-    return visit_impl<Ret_T>(::std::forward<Visitor_T>(visitor), indices, make_ddispatch_pair(::std::forward<Storage_T1>(v1), ::std::forward<Storage_T2>(v2)));
+    return visit_impl<Ret_T>(::std::forward<Visitor_T>(visitor), index, make_ddispatch_pair(::std::forward<Storage_T1>(v1), ::std::forward<Storage_T2>(v2)));
 }
 
 // === generic constructor callables, to be applied with the function above
@@ -290,6 +512,15 @@ struct move_construct_alternative {
         ::new (&pair.lhs) typename Pair_T::underlying_t{::std::move(pair.rhs)};
     }
 };
+// moves rhs into lhs and ends the lifetime of rhs within the same dispatch
+struct relocate_alternative {
+    template<typename Pair_T>
+    constexpr void operator()(const Pair_T& pair) const {
+        using underlying_t = typename Pair_T::underlying_t;
+        ::new (&pair.lhs) underlying_t{::std::move(pair.rhs)};
+        pair.rhs.~underlying_t();
+    }
+};
 struct copy_assign_alternative {
     template<typename Pair_T>
     constexpr void operator()(const Pair_T& pair) const {
@@ -358,17 +589,63 @@ struct spaceship_alternative {
 struct hash_alternative {
     template<typename Container_T>
     constexpr ::std::size_t operator()(const Container_T& v) const {
-        return ::std::hash<::std::remove_cv<Container_T>>{}(v);
+        return ::std::hash<::std::remove_cv_t<Container_T>>{}(v);
     }
 };
 
+// === trivial alternative fast paths
+/*
+ * Bit I is set when alternative I is handled bytewise, indices past 63 and the valueless index always dispatch.
+ * Trivially copyable alternatives start at offset 0 of single buffered storage, copying the widest of them covers any
+ */
+constexpr ::std::uint64_t make_alternative_mask(::std::initializer_list<bool> flags) noexcept {
+    ::std::uint64_t mask = 0;
+    ::std::size_t i = 0;
+    for (const bool flag : flags) {
+        if (flag && i < 64)
+            mask |= ::std::uint64_t{1} << i;
+        ++i;
+    }
+    return mask;
+}
+constexpr bool alternative_in_mask(::std::uint64_t mask, ::std::size_t index) noexcept {
+    return index < 64 && ((mask >> index) & 1) != 0;
+}
+
+template<typename Var_T>
+void destroy_variant_alternative(Var_T& v) {
+    if (!alternative_in_mask(Var_T::trivial_destroy_mask, v._index))
+        visit_impl(destroy_alternative{}, v._index, v._storage);
+}
+
+// rhs holds a bytewise copyable alternative, lhs is valueless or trivially destructible
+template<typename Var_Lhs, typename Var_Rhs>
+void copy_trivial_alternative(Var_Lhs& lhs, const Var_Rhs& rhs) noexcept {
+    ::std::memcpy(static_cast<void*>(&lhs._storage), static_cast<const void*>(&rhs._storage), Var_Lhs::alternative_sizes::table[rhs._index]);
+    lhs._index = rhs._index;
+}
+
+template<typename Var_Lhs, typename Var_Rhs>
+bool assign_trivial_alternative(Var_Lhs& lhs, const Var_Rhs& rhs) noexcept {
+    constexpr auto npos = variant_index_npos<Var_Lhs::size>;
+    if (!alternative_in_mask(Var_Lhs::trivial_copy_mask, rhs._index))
+        return false;
+    if (lhs._index != npos && !alternative_in_mask(Var_Lhs::trivial_destroy_mask, lhs._index))
+        return false;
+    copy_trivial_alternative(lhs, rhs);
+    return true;
+}
+
 // === generic copy/move of two variants
 template<typename Var_Lhs, typename Var_Rhs, typename Ctor_Fun, typename Ass_Fun>
 constexpr auto& assign_variants(Var_Lhs&& lhs, Var_Rhs&& rhs, Ctor_Fun ctor, Ass_Fun ass) {
-    if (rhs._index == variant_npos) {
-        if (lhs._index != variant_npos) {
-            visit_impl(destroy_alternative{}, lhs._index, lhs._storage);
-            lhs._index = variant_npos;
+    constexpr auto npos = variant_index_npos<remove_cvref_t<Var_Lhs>::size>;
+    IDYM_INTERNAL_INSTRUMENT(typename remove_cvref_t<Var_Lhs>::variant_type, assign, rhs._index);
+
+    if (rhs._index == npos) {
+        if (lhs._index != npos) {
+            destroy_variant_alternative(lhs);
+            lhs._index = npos;
         }
         return lhs;
     }
@@ -376,9 +653,9 @@ constexpr auto& assign_variants(Var_Lhs&& lhs, Var_Rhs&& rhs, Ctor_Fun ctor, Ass
     if (lhs._index == rhs._index) {
         visit_impl(ass, lhs._index, lhs._storage, rhs._storage);
     } else {
-        if (lhs._index != variant_npos) {
-            visit_impl(destroy_alternative{}, lhs._index, lhs._storage);
-            lhs._index = variant_npos;
+        if (lhs._index != npos) {
+            destroy_variant_alternative(lhs);
+            lhs._index = npos;
         }
         
         visit_impl(ctor, rhs._index, lhs._storage, rhs._storage);
@@ -387,33 +664,108 @@ constexpr auto& assign_variants(Var_Lhs&& lhs, Var_Rhs&& rhs, Ctor_Fun ctor, Ass
     return lhs;
 }
 
+// === never valueless replacement
+/*
+ * Switches a never valueless variant to alternative I, the old alternative is destroyed only once nothing can throw:
+ * - nothrow construction from Args happens in place
+ * - single buffered storage implies nothrow moves, the alternative is built in a temporary and moved in
+ * - double buffered storage builds it in the spare buffer and flips the buffers
+ */
+template<typename T, typename Storage_T, typename... Args>
+using replace_strategy = ::std::integral_constant<int,
+    ::std::is_nothrow_constructible<T, Args...>::value ? 0 : (is_double_storage<Storage_T>::value ? 2 : 1)
+>;
+
+template<::std::size_t I, typename T, typename Var_T, typename... Args>
+constexpr void replace_alternative_impl(::std::integral_constant<int, 0>, Var_T& v, Args&&... args) {
+    destroy_variant_alternative(v);
+    ::new (get_variant_storage<I>::do_get(v._storage)) T(::std::forward<Args>(args)...);
+    v._index = I;
+}
+template<::std::size_t I, typename T, typename Var_T, typename... Args>
+constexpr void replace_alternative_impl(::std::integral_constant<int, 1>, Var_T& v, Args&&... args) {
+    T tmp(::std::forward<Args>(args)...);
+    replace_alternative_impl<I, T>(::std::integral_constant<int, 0>{}, v, ::std::move(tmp));
+}
+template<::std::size_t I, typename T, typename Var_T, typename... Args>
+constexpr void replace_alternative_impl(::std::integral_constant<int, 2>, Var_T& v, Args&&... args) {
+    ::new (get_variant_storage<I>::do_get(v._storage.buffers[v._storage.active ^ 1])) T(::std::forward<Args>(args)...);
+    destroy_variant_alternative(v);
+    v._storage.active ^= 1;
+    v._index = I;
+}
+
+template<::std::size_t I, typename Var_T, typename... Args>
+constexpr void replace_alternative(Var_T& v, Args&&... args) {
+    using alt_t = ::std::remove_pointer_t<decltype(get_variant_storage<I>::do_get(v._storage))>;
+    replace_alternative_impl<I, alt_t>(replace_strategy<alt_t, decltype(v._storage), Args...>{}, v, ::std::forward<Args>(args)...);
+}
+
+template<::std::size_t I, typename Var_T, typename Src_T>
+constexpr void replace_from_variant(Var_T& lhs, Src_T&& rhs) {
+    auto* alt_ptr = get_variant_storage<I>::do_get(rhs._storage);
+    using alt_ref_t = ::std::conditional_t<
+        ::std::is_lvalue_reference<Src_T>::value,
+        decltype(*alt_ptr),
+        ::std::remove_reference_t<decltype(*alt_ptr)>&&
+    >;
+    replace_alternative<I>(lhs, static_cast<alt_ref_t>(*alt_ptr));
+}
+
+template<typename Var_T, typename Src_T, ::std::size_t... Is>
+constexpr void replace_from_variant_dispatch(::std::index_sequence<Is...>, Var_T& lhs, Src_T&& rhs) {
+    using dispatch_ptr_t = void (*)(Var_T&, Src_T&&);
+    using replace_dispatch_table = static_dispatch_table<dispatch_ptr_t, &replace_from_variant<Is, Var_T, Src_T>...>;
+    replace_dispatch_table::table[rhs._index](lhs, ::std::forward<Src_T>(rhs));
+}
+
+// === never valueless copy/move of two variants
+template<typename Var_Lhs, typename Var_Rhs, typename Ass_Fun>
+constexpr auto& assign_never_valueless(Var_Lhs& lhs, Var_Rhs&& rhs, Ass_Fun ass) {
+    if (lhs._index == rhs._index)
+        visit_impl(ass, lhs._index, lhs._storage, rhs._storage);
+    else
+        replace_from_variant_dispatch(::std::make_index_sequence<Var_Lhs::size>{}, lhs, ::std::forward<Var_Rhs>(rhs));
+    return lhs;
+}
+
 // === variant_base
-template<bool, typename... Ts>
+template<bool, bool Never_Valueless, typename... Ts>
 struct variant_base_ncopy_ass {
+    using variant_type = basic_variant<Never_Valueless, Ts...>;
+
     static constexpr ::std::size_t size = sizeof...(Ts);
+    static constexpr bool never_valueless = Never_Valueless;
+
+    // double buffered storage moves alternatives off offset 0, only destruction is skipped there
+    static constexpr bool bytewise_storage = !is_double_storage<variant_storage_select<Never_Valueless, Ts...>>::value;
+    static constexpr ::std::uint64_t trivial_copy_mask = bytewise_storage ? make_alternative_mask({is_bytewise_copyable<Ts>::value...}) : 0;
+    static constexpr ::std::uint64_t trivial_destroy_mask = make_alternative_mask({::std::is_trivially_destructible<Ts>::value...});
+    // copying the active alternative only leaves the bytes past it untouched, rather than reading them uninitialized
+    using alternative_sizes = static_dispatch_table<::std::size_t, sizeof(Ts)...>;
 
-    variant_storage<Ts...> _storage;
-    ::std::size_t _index = variant_npos;
+    variant_storage_select<Never_Valueless, Ts...> _storage;
+    variant_index_t<sizeof...(Ts)> _index = variant_index_npos<sizeof...(Ts)>;
 };
-template<typename... Ts>
-struct variant_base_ncopy_ass<false, Ts...> : variant_base_ncopy_ass<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_ncopy_ass<false, Never_Valueless, Ts...> : variant_base_ncopy_ass<true, Never_Valueless, Ts...> {
     variant_base_ncopy_ass& operator=(const variant_base_ncopy_ass&) = delete;
 };
 
-template<bool, typename... Ts>
+template<bool, bool Never_Valueless, typename... Ts>
 struct variant_base_nmove_ass : variant_base_ncopy_ass<
     conjunction_v<::std::is_copy_constructible<Ts>...> && conjunction_v<::std::is_copy_assignable<Ts>...>,
-    Ts...
+    Never_Valueless, Ts...
 > {};
-template<typename... Ts>
-struct variant_base_nmove_ass<false, Ts...> : variant_base_nmove_ass<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_nmove_ass<false, Never_Valueless, Ts...> : variant_base_nmove_ass<true, Never_Valueless, Ts...> {
     variant_base_nmove_ass& operator=(variant_base_nmove_ass&&) = delete;
 };
 
-template<typename... Ts>
+template<bool Never_Valueless, typename... Ts>
 struct variant_base : variant_base_nmove_ass<
     conjunction_v<::std::is_move_constructible<Ts>...> && conjunction_v<::std::is_move_assignable<Ts>...>,
-    Ts...
+    Never_Valueless, Ts...
 > {};
 
 template<typename... Ts>
@@ -423,38 +775,44 @@ constexpr bool move_ass_nothrow = conjunction_v<::std::is_nothrow_move_construct
  * For each base, the first bool is:
  * - true for trivial OR deleted
  * - false otherwise(non-trivial)
+ * The second one selects the never valueless behaviour, which turns every valueless check below into a constant
  */
 // === variant_base_dtor
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_dtor;
 
-template<typename... Ts>
-struct variant_base_dtor<true, Ts...> : variant_base<Ts...> {};
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_dtor<true, Never_Valueless, Ts...> : variant_base<Never_Valueless, Ts...> {};
 
-template<typename... Ts>
-struct variant_base_dtor<false, Ts...> : variant_base_dtor<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_dtor<false, Never_Valueless, Ts...> : variant_base_dtor<true, Never_Valueless, Ts...> {
+    // never valueless variants still hold npos here when a converting or copy/move constructor throws
     IDYM_INTERNAL_CXX20_CONSTEXPR_DTOR ~variant_base_dtor() {
-        if (this->_index != variant_npos)
-            visit_impl(destroy_alternative{}, this->_index, this->_storage);
+        if (this->_index != variant_index_npos<sizeof...(Ts)>)
+            destroy_variant_alternative(*this);
     }
 };
 
 // === variant_base_copy_ctor
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_copy_ctor;
 
-template<typename... Ts>
-struct variant_base_copy_ctor<true, Ts...> : variant_base_dtor<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_copy_ctor<true, Never_Valueless, Ts...> : variant_base_dtor<
     conjunction_v<::std::is_trivially_destructible<Ts>...>,
-    Ts...
+    Never_Valueless, Ts...
 > {};
 
-template<typename... Ts>
-struct variant_base_copy_ctor<false, Ts...> : variant_base_copy_ctor<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_copy_ctor<false, Never_Valueless, Ts...> : variant_base_copy_ctor<true, Never_Valueless, Ts...> {
     constexpr variant_base_copy_ctor() = default;
     constexpr variant_base_copy_ctor(const variant_base_copy_ctor& other) {
-        if (other._index == variant_npos)
+        if (!Never_Valueless && other._index == variant_index_npos<sizeof...(Ts)>)
+            return;
+        if (alternative_in_mask(this->trivial_copy_mask, other._index)) {
+            copy_trivial_alternative(*this, other);
             return;
+        }
         visit_impl(copy_construct_alternative{}, other._index, this->_storage, other._storage);
         this->_index = other._index;
     }
@@ -464,13 +822,13 @@ struct variant_base_copy_ctor<false, Ts...> : variant_base_copy_ctor<true, Ts...
 };
 
 // === variant_base_move_ctor
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_move_ctor;
 
-template<typename... Ts>
-struct variant_base_move_ctor<true, Ts...> : variant_base_copy_ctor<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_move_ctor<true, Never_Valueless, Ts...> : variant_base_copy_ctor<
     conjunction_v<::std::is_trivially_copy_constructible<Ts>...> || !conjunction_v<::std::is_copy_constructible<Ts>...>,
-    Ts...
+    Never_Valueless, Ts...
 >
 {
     constexpr variant_base_move_ctor() = default;
@@ -481,13 +839,17 @@ struct variant_base_move_ctor<true, Ts...> : variant_base_copy_ctor<
     constexpr variant_base_move_ctor& operator=(variant_base_move_ctor&&) noexcept(move_ass_nothrow<Ts...>) = default;
 };
 
-template<typename... Ts>
-struct variant_base_move_ctor<false, Ts...> : variant_base_move_ctor<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_move_ctor<false, Never_Valueless, Ts...> : variant_base_move_ctor<true, Never_Valueless, Ts...> {
     constexpr variant_base_move_ctor() = default;
     constexpr variant_base_move_ctor(const variant_base_move_ctor&) = default;
     constexpr variant_base_move_ctor(variant_base_move_ctor&& other) noexcept(conjunction_v<::std::is_nothrow_move_constructible<Ts>...>) {
-        if (other._index == variant_npos)
+        if (!Never_Valueless && other._index == variant_index_npos<sizeof...(Ts)>)
             return;
+        if (alternative_in_mask(this->trivial_copy_mask, other._index)) {
+            copy_trivial_alternative(*this, other);
+            return;
+        }
         visit_impl(move_construct_alternative{}, other._index, this->_storage, other._storage);
         this->_index = other._index;
     }
@@ -497,13 +859,13 @@ struct variant_base_move_ctor<false, Ts...> : variant_base_move_ctor<true, Ts...
 };
 
 // === variant_base_move_ass
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_move_ass;
 
-template<typename... Ts>
-struct variant_base_move_ass<true, Ts...> : variant_base_move_ctor<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_move_ass<true, Never_Valueless, Ts...> : variant_base_move_ctor<
     conjunction_v<::std::is_trivially_move_constructible<Ts>...> || !conjunction_v<::std::is_move_constructible<Ts>...>,
-    Ts...
+    Never_Valueless, Ts...
 >
 {
     constexpr variant_base_move_ass() = default;
@@ -513,53 +875,73 @@ struct variant_base_move_ass<true, Ts...> : variant_base_move_ctor<
     constexpr variant_base_move_ass& operator=(variant_base_move_ass&&) noexcept(move_ass_nothrow<Ts...>) = default;
 };
 
-template<typename... Ts>
-struct variant_base_move_ass<false, Ts...> : variant_base_move_ass<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_move_ass<false, Never_Valueless, Ts...> : variant_base_move_ass<true, Never_Valueless, Ts...> {
     constexpr variant_base_move_ass() = default;
     constexpr variant_base_move_ass(const variant_base_move_ass&) = default;
     constexpr variant_base_move_ass(variant_base_move_ass&&) noexcept(conjunction_v<::std::is_nothrow_move_constructible<Ts>...>) = default;
     constexpr variant_base_move_ass& operator=(const variant_base_move_ass&) = default;
 
     constexpr variant_base_move_ass& operator=(variant_base_move_ass&& other) noexcept(move_ass_nothrow<Ts...>) {
+        return move_assign_impl(::std::integral_constant<bool, Never_Valueless>{}, other);
+    }
+
+private:
+    constexpr variant_base_move_ass& move_assign_impl(::std::false_type, variant_base_move_ass& other) {
+        if (assign_trivial_alternative(*this, other))
+            return *this;
         return assign_variants(*this, other, move_construct_alternative{}, move_assign_alternative{});
     }
+    constexpr variant_base_move_ass& move_assign_impl(::std::true_type, variant_base_move_ass& other) {
+        if (assign_trivial_alternative(*this, other))
+            return *this;
+        return assign_never_valueless(*this, ::std::move(other), move_assign_alternative{});
+    }
 };
 
 // === variant_base_copy_ass
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_copy_ass;
 
-template<typename... Ts>
-struct variant_base_copy_ass<true, Ts...> : variant_base_move_ass<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_copy_ass<true, Never_Valueless, Ts...> : variant_base_move_ass<
     (
         conjunction_v<::std::is_trivially_move_constructible<Ts>...> &&
         conjunction_v<::std::is_trivially_move_assignable<Ts>...> &&
         conjunction_v<::std::is_trivially_destructible<Ts>...>
     ) || (!conjunction_v<::std::is_move_constructible<Ts>...> || !conjunction_v<::std::is_move_assignable<Ts>...>),
-    Ts...
+    Never_Valueless, Ts...
 > {};
 
-template<typename... Ts>
-struct variant_base_copy_ass<false, Ts...> : variant_base_copy_ass<true, Ts...> {
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_copy_ass<false, Never_Valueless, Ts...> : variant_base_copy_ass<true, Never_Valueless, Ts...> {
     constexpr variant_base_copy_ass() = default;
     constexpr variant_base_copy_ass(const variant_base_copy_ass&) = default;
     constexpr variant_base_copy_ass(variant_base_copy_ass&&) noexcept(conjunction_v<::std::is_nothrow_move_constructible<Ts>...>) = default;
 
     constexpr variant_base_copy_ass& operator=(variant_base_copy_ass&&) noexcept(move_ass_nothrow<Ts...>) = default;
     constexpr variant_base_copy_ass& operator=(const variant_base_copy_ass& other) {
+        copy_assign_dispatch(::std::integral_constant<bool, Never_Valueless>{}, other);
+        return *this;
+    }
+    
+private:
+    constexpr void copy_assign_dispatch(::std::true_type, const variant_base_copy_ass& other) {
+        if (!assign_trivial_alternative(*this, other))
+            assign_never_valueless(*this, other, copy_assign_alternative{});
+    }
+    constexpr void copy_assign_dispatch(::std::false_type, const variant_base_copy_ass& other) {
+        if (assign_trivial_alternative(*this, other))
+            return;
         using dispatch_ptr_t = void (variant_base_copy_ass::*)(const variant_base_copy_ass&);
-        constexpr dispatch_ptr_t copy_dispatch_table[] = {
-            &variant_base_copy_ass::call_copy_assign_impl<Ts>...
-        };
+        using copy_dispatch_table = static_dispatch_table<dispatch_ptr_t, &variant_base_copy_ass::call_copy_assign_impl<Ts>...>;
         
-        if (other._index != variant_npos && other._index != this->_index)
-            (this->*(copy_dispatch_table[other._index]))(other);
+        if (other._index != variant_index_npos<sizeof...(Ts)> && other._index != this->_index)
+            (this->*(copy_dispatch_table::table[other._index]))(other);
         else
             copy_assign_impl(::std::true_type{}, other);
-        return *this;
     }
-    
-private:
+
     template<typename T>
     constexpr void call_copy_assign_impl(const variant_base_copy_ass& other) {
         constexpr auto use_emplace = ::std::is_nothrow_copy_constructible<T>::value || !::std::is_nothrow_move_constructible<T>::value;
@@ -578,34 +960,34 @@ private:
 template<typename... Ts>
 constexpr bool var_def_ctor_nothrow_v = ::std::is_nothrow_default_constructible<_internal::first_of_t<Ts...>>::value;
 
-template<bool, typename...>
+template<bool, bool, typename...>
 struct variant_base_def_ctor;
 
-template<typename... Ts>
-struct variant_base_def_ctor<true, Ts...> : variant_base_copy_ass<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_def_ctor<true, Never_Valueless, Ts...> : variant_base_copy_ass<
     (
         conjunction_v<::std::is_trivially_copy_constructible<Ts>...> && 
         conjunction_v<::std::is_trivially_copy_assignable<Ts>...> && 
         conjunction_v<::std::is_trivially_destructible<Ts>...>
     ) || (!conjunction_v<::std::is_copy_constructible<Ts>...> || !conjunction_v<::std::is_copy_assignable<Ts>...>),
-    Ts...
+    Never_Valueless, Ts...
 >
 {
     constexpr variant_base_def_ctor() noexcept(var_def_ctor_nothrow_v<first_of_t<Ts...>>) {
-        ::new (&this->_storage.v0) first_of_t<Ts...>{};
+        ::new (get_variant_storage<0>::do_get(this->_storage)) first_of_t<Ts...>{};
         this->_index = 0;
     }
     constexpr variant_base_def_ctor(dummy_t) {} 
 };
 
-template<typename... Ts>
-struct variant_base_def_ctor<false, Ts...> : variant_base_copy_ass<
+template<bool Never_Valueless, typename... Ts>
+struct variant_base_def_ctor<false, Never_Valueless, Ts...> : variant_base_copy_ass<
     (
         conjunction_v<::std::is_trivially_copy_constructible<Ts>...> && 
         conjunction_v<::std::is_trivially_copy_assignable<Ts>...> && 
         conjunction_v<::std::is_trivially_destructible<Ts>...>
     ) || (!conjunction_v<::std::is_copy_constructible<Ts>...> || !conjunction_v<::std::is_copy_assignable<Ts>...>),
-    Ts...
+    Never_Valueless, Ts...
 >
 {
     variant_base_def_ctor() = delete;
@@ -613,10 +995,10 @@ struct variant_base_def_ctor<false, Ts...> : variant_base_copy_ass<
 };
 
 // === variant_base_final
-template<typename... Ts>
+template<bool Never_Valueless, typename... Ts>
 using variant_base_final = variant_base_def_ctor<
     ::std::is_default_constructible<first_of_t<Ts...>>::value,
-    Ts...
+    Never_Valueless, Ts...
 >;
 
 // === constraint checks
@@ -632,25 +1014,45 @@ struct instanceof_in_place_index<in_place_index_t<I>> : ::std::true_type {};
 
 // === varaint(T&&) and operator=(T&&) constraint deduction
 /*
+ * One operator() per alternative, viable only if T x[] = {u} is well formed.
  * Unique_I exists to guard against inaccessible bases
  * + to fascilicate the detection of erroneous overload resolution on gcc 6.4
- * as it doesn't care about ambiguous calls and chooses the first "used" inherited operator
+ * as it doesn't care about ambiguous calls and chooses the first "used" inherited operator,
+ * the set is instantiated in both inheritance orders there and the results have to agree
  */
-template<typename T, ::std::size_t Unique_I> 
-struct variant_overload;
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 7
+  #define IDYM_INTERNAL_OVERLOAD_SET_BOTH_ORDERS
+#endif
 
-template<typename T, ::std::size_t Unique_I>
-auto test_overload(T (&&)[1]) -> variant_overload<T, Unique_I>;
+template<typename T>
+using overload_array_t = T[1];
 
 template<typename T, ::std::size_t Unique_I> 
 struct variant_overload {
     using type = T;
     static constexpr ::std::size_t value = Unique_I;
 
+    // a pointer, the class isn't complete yet
     template<typename U>
-    auto operator()(T, U&&) -> decltype(test_overload<T, Unique_I>({::std::declval<U>()}));
+    auto operator()(T, U&&) -> decltype(static_cast<void>(overload_array_t<T>{::std::declval<U>()}), static_cast<variant_overload*>(nullptr));
+};
+
+#if __cpp_variadic_using >= 201611L && !defined(IDYM_INTERNAL_OVERLOAD_SET_BOTH_ORDERS)
+// flat, every overload is a direct base
+template<typename, typename...>
+struct variant_overload_set_flat;
+
+template<::std::size_t... Is, typename... Ts>
+struct variant_overload_set_flat<::std::index_sequence<Is...>, Ts...> : variant_overload<Ts, Is>... {
+    using variant_overload<Ts, Is>::operator()...;
 };
 
+template<typename Arg_T, typename... Ts>
+using variant_ctor_compat_t = typename ::std::remove_pointer_t<decltype(
+    ::std::declval<variant_overload_set_flat<::std::index_sequence_for<Ts...>, Ts...>>()(::std::declval<Arg_T>(), ::std::declval<Arg_T>())
+)>::type;
+#else
+// a chain of bases, each bringing one overload into scope alongside the rest
 template<bool, typename...>
 struct variant_overload_set;
 
@@ -674,6 +1076,12 @@ struct variant_overload_set<false, T> : variant_overload<T, 0> {
     using variant_overload<T, 0>::operator();
 };
 
+template<bool Order, typename Arg_T, typename... Ts>
+using variant_overload_result_t = ::std::remove_pointer_t<
+    decltype(::std::declval<variant_overload_set<Order, Ts...>>()(::std::declval<Arg_T>(), ::std::declval<Arg_T>()))
+>;
+
+  #ifdef IDYM_INTERNAL_OVERLOAD_SET_BOTH_ORDERS
 template<typename T_Overload1, typename T_Overload2, typename = void>
 struct variant_overload_resolver;
 
@@ -682,71 +1090,59 @@ struct variant_overload_resolver<T_Overload1, T_Overload2, ::std::enable_if_t<T_
     using type = typename T_Overload1::type;
 };
 
-template<typename F, typename... Ts>
-auto test_overloads(F&& f, Ts&&... args) -> decltype(::std::forward<F>(f)(::std::forward<Ts>(args)...));
-
 template<typename Arg_T, typename... Ts>
 using variant_ctor_compat_t = typename variant_overload_resolver<
-    decltype(::std::declval<variant_overload_set<false, Ts...>>()(::std::declval<Arg_T>(), ::std::declval<Arg_T>())),
-    decltype(::std::declval<variant_overload_set<true, Ts...>>()(::std::declval<Arg_T>(), ::std::declval<Arg_T>()))
+    variant_overload_result_t<false, Arg_T, Ts...>,
+    variant_overload_result_t<true, Arg_T, Ts...>
 >::type;
+  #else
+template<typename Arg_T, typename... Ts>
+using variant_ctor_compat_t = typename variant_overload_result_t<false, Arg_T, Ts...>::type;
+  #endif
+#endif
 
-// === alternative_to_index
-template<::std::size_t, typename, typename...>
-struct alternative_to_index : ::std::integral_constant<::std::size_t, variant_npos> {};
-
-template<::std::size_t I, typename Target_T, typename T, typename... Ts>
-struct alternative_to_index<I, Target_T, T, Ts...> : alternative_to_index<I + 1, Target_T, Ts...> {};
-
+// === alternative_to_index, I plus the position of the first Target_T in Ts or variant_npos
+// types occurring once resolve through unique_index_t, only missing and repeated types scan the pack
+template<bool, ::std::size_t I, typename Target_T, typename... Ts>
+struct alternative_to_index_impl : ::std::integral_constant<::std::size_t, I + unique_index_t<Target_T, Ts...>::value> {};
 template<::std::size_t I, typename Target_T, typename... Ts>
-struct alternative_to_index<I, Target_T, Target_T, Ts...> : ::std::integral_constant<::std::size_t, I> {};
-
-template<::std::size_t, typename, typename>
-struct alternative_to_index_helper;
+struct alternative_to_index_impl<false, I, Target_T, Ts...> : ::std::integral_constant<::std::size_t, first_match({IDYM_INTERNAL_IS_SAME(Target_T, Ts)...}, I)> {};
 
 template<::std::size_t I, typename Target_T, typename... Ts>
-struct alternative_to_index_helper<I, Target_T, variant_base<Ts...>> : alternative_to_index<I, Target_T, Ts...> {};
-
-// === index_to_alternative
-template<::std::size_t, typename... Ts>
-struct index_to_alternative;
-
-template<::std::size_t I>
-struct index_to_alternative<I> {};
-template<::std::size_t I, typename T, typename... Ts>
-struct index_to_alternative<I, T, Ts...> : index_to_alternative<I - 1, Ts...> {};
-
-template<typename T, typename... Ts>
-struct index_to_alternative<0, T, Ts...> {
-    using type = T;
-};
-
-template<::std::size_t I, typename... Ts>
-using index_to_alternative_t = typename index_to_alternative<I, Ts...>::type;
+struct alternative_to_index : alternative_to_index_impl<unique_index_t<Target_T, Ts...>::value != variant_npos, I, Target_T, Ts...> {};
 
 // === type_occurrence_count
-template<typename, typename...>
-struct type_occurrence_count;
+template<bool, typename Target_T, typename... Ts>
+struct type_occurrence_count_impl : ::std::integral_constant<::std::size_t, 1> {};
+template<typename Target_T, typename... Ts>
+struct type_occurrence_count_impl<false, Target_T, Ts...> : ::std::integral_constant<::std::size_t, count_matches({IDYM_INTERNAL_IS_SAME(Target_T, Ts)...})> {};
 
-template<typename Target_T, typename T, typename... Ts>
-struct type_occurrence_count<Target_T, T, Ts...> {
-    static constexpr ::std::size_t value = type_occurrence_count<Target_T, Ts...>::value;
-};
 template<typename Target_T, typename... Ts>
-struct type_occurrence_count<Target_T, Target_T, Ts...> {
-    static constexpr ::std::size_t value = 1 + type_occurrence_count<Target_T, Ts...>::value;
+struct type_occurrence_count : type_occurrence_count_impl<unique_index_t<Target_T, Ts...>::value != variant_npos, Target_T, Ts...> {};
+
+template<typename T, bool Never_Valueless, typename... Ts>
+struct type_occurrence_count<T, variant_base<Never_Valueless, Ts...>> : type_occurrence_count<T, Ts...> {};
+
+// === boxed_lookup, T as an alternative or, if there's none, as the content of a boxed one
+template<bool Direct, typename T, typename... Ts>
+struct boxed_lookup_impl {
+    static constexpr ::std::size_t count = type_occurrence_count<T, Ts...>::value;
+    static constexpr ::std::size_t index = alternative_to_index<0, T, Ts...>::value;
 };
-template<typename Target_T>
-struct type_occurrence_count<Target_T> {
-    static constexpr ::std::size_t value = 0;
+template<typename T, typename... Ts>
+struct boxed_lookup_impl<false, T, Ts...> {
+    static constexpr ::std::size_t count = type_occurrence_count<T, unboxed_t<Ts>...>::value;
+    static constexpr ::std::size_t index = alternative_to_index<0, T, unboxed_t<Ts>...>::value;
 };
 
 template<typename T, typename... Ts>
-struct type_occurrence_count<T, variant_base<Ts...>> : type_occurrence_count<T, Ts...> {};
+struct boxed_lookup : boxed_lookup_impl<type_occurrence_count<T, Ts...>::value != 0, T, Ts...> {};
+template<typename T, bool Never_Valueless, typename... Ts>
+struct boxed_lookup<T, variant_base<Never_Valueless, Ts...>> : boxed_lookup<T, Ts...> {};
 
 // === alternative constructor
-template<::std::size_t I, typename... Alt_Ts, typename... Ts>
-constexpr auto* init_alternative_at(variant_base<Alt_Ts...>& storage, Ts&&... args) {
+template<::std::size_t I, bool Never_Valueless, typename... Alt_Ts, typename... Ts>
+constexpr auto* init_alternative_at(variant_base<Never_Valueless, Alt_Ts...>& storage, Ts&&... args) {
     auto* alt_ptr = get_variant_storage<I>::do_get(storage._storage);
     ::new (alt_ptr) ::std::remove_pointer_t<decltype(alt_ptr)>(std::forward<Ts>(args)...);
     storage._index = I;
@@ -761,21 +1157,40 @@ constexpr auto get_if_impl(Variant_T&& v) {
 }
 template<typename T, typename Variant_T>
 constexpr auto get_if_impl(Variant_T&& v) {
-    static_assert(type_occurrence_count<T, remove_cvref_t<Variant_T>>::value == 1, "T has to occur in Ts exactly once");
-    return get_if_impl<alternative_to_index_helper<0, T, remove_cvref_t<Variant_T>>::value>(::std::forward<Variant_T>(v));
+    using lookup_t = boxed_lookup<T, remove_cvref_t<Variant_T>>;
+    static_assert(lookup_t::count == 1, "T has to occur in Ts exactly once");
+    return unbox_ptr(get_if_impl<lookup_t::index>(::std::forward<Variant_T>(v)));
 }
 
 template<::std::size_t I, typename Variant_T>
 constexpr auto get_impl(Variant_T&& v) {
+    IDYM_INTERNAL_INSTRUMENT(typename remove_cvref_t<Variant_T>::variant_type, get, v._index);
     if (auto ptr = get_if_impl<I>(::std::forward<Variant_T>(v)))
         return ptr;
-    throw bad_variant_access{};
+    IDYM_INTERNAL_INSTRUMENT(typename remove_cvref_t<Variant_T>::variant_type, bad_access, v._index);
+    IDYM_INTERNAL_THROW(bad_variant_access{});
 }
 template<typename T, typename Variant_T>
 constexpr auto get_impl(Variant_T&& v) {
+    IDYM_INTERNAL_INSTRUMENT(typename remove_cvref_t<Variant_T>::variant_type, get, v._index);
     if (auto ptr = get_if_impl<T>(::std::forward<Variant_T>(v)))
         return ptr;
-    throw bad_variant_access{};
+    IDYM_INTERNAL_INSTRUMENT(typename remove_cvref_t<Variant_T>::variant_type, bad_access, v._index);
+    IDYM_INTERNAL_THROW(bad_variant_access{});
+}
+
+// === get_unchecked_impl
+template<::std::size_t I, typename Variant_T>
+constexpr auto get_unchecked_impl(Variant_T&& v) noexcept {
+    static_assert(I < remove_cvref_t<Variant_T>::size, "I is required to be less than the alternative count");
+    IDYM_INTERNAL_ASSERT(v._index == I, "Variant has to hold the alternative");
+    return get_variant_storage<I>::do_get(v._storage);
+}
+template<typename T, typename Variant_T>
+constexpr auto get_unchecked_impl(Variant_T&& v) noexcept {
+    using lookup_t = boxed_lookup<T, remove_cvref_t<Variant_T>>;
+    static_assert(lookup_t::count == 1, "T has to occur in Ts exactly once");
+    return unbox_ptr(get_unchecked_impl<lookup_t::index>(::std::forward<Variant_T>(v)));
 }
 
 // === relational tests
@@ -815,8 +1230,8 @@ struct geq_test<T, void_t<decltype(static_cast<bool>(::std::declval<T>() >= ::st
 template<::std::size_t I, typename T>
 struct variant_alternative;
 
-template<::std::size_t I, typename... Ts>
-struct variant_alternative<I, variant<Ts...>> : _internal::index_to_alternative<I, Ts...> {};
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+struct variant_alternative<I, basic_variant<Never_Valueless, Ts...>> : _internal::index_to_alternative<I, Ts...> {};
 template<::std::size_t I, typename T>
 struct variant_alternative<I, const T> : variant_alternative<I, T> {};
 template<::std::size_t I, typename T>
@@ -831,8 +1246,8 @@ using variant_alternative_t = typename variant_alternative<I, T>::type;
 template<typename>
 struct variant_size;
 
-template<typename... Ts>
-struct variant_size<variant<Ts...>> : ::std::integral_constant<::std::size_t, sizeof...(Ts)> {};
+template<bool Never_Valueless, typename... Ts>
+struct variant_size<basic_variant<Never_Valueless, Ts...>> : ::std::integral_constant<::std::size_t, sizeof...(Ts)> {};
 template<typename T>
 struct variant_size<const T> : variant_size<T> {};
 template<typename T>
@@ -843,26 +1258,26 @@ struct IDYM_INTERNAL_CXX20_DEPRECATED_VARIANT variant_size<const volatile T> : v
 template<typename T>
 constexpr ::std::size_t variant_size_v = variant_size<T>::value;
 
-// === variant
-template<typename... Ts>
-class variant : _internal::variant_base_final<Ts...> {
+// === basic_variant, spelled as variant or never_valueless_variant
+template<bool Never_Valueless, typename... Ts>
+class basic_variant : _internal::variant_base_final<Never_Valueless, Ts...> {
     static_assert(sizeof...(Ts) > 0, "Variant must have at least one alternative");
 
 public:
-    constexpr variant() noexcept(_internal::var_def_ctor_nothrow_v<Ts...>) = default;
+    constexpr basic_variant() noexcept(_internal::var_def_ctor_nothrow_v<Ts...>) = default;
     
     template<
         typename T,
         ::std::enable_if_t<
-            !::std::is_same<remove_cvref_t<T>, variant>::value &&
+            !::std::is_same<remove_cvref_t<T>, basic_variant>::value &&
             !_internal::instanceof_in_place_type<remove_cvref_t<T>>::value &&
             !_internal::instanceof_in_place_index<remove_cvref_t<T>>::value,
         bool> = true,
         typename Compat_Ctor_T = _internal::variant_ctor_compat_t<T, Ts...>, // MSVC 19.16 bug, has to be expanded before usage in a constraint
         ::std::enable_if_t<::std::is_constructible<Compat_Ctor_T, T>::value, bool> = true
     >
-    constexpr variant(T&& t) noexcept(::std::is_nothrow_constructible<Compat_Ctor_T, T>::value) :
-        variant{in_place_type<Compat_Ctor_T>, ::std::forward<T>(t)}
+    constexpr basic_variant(T&& t) noexcept(::std::is_nothrow_constructible<Compat_Ctor_T, T>::value) :
+        basic_variant{in_place_type<Compat_Ctor_T>, ::std::forward<T>(t)}
     {
     }
     
@@ -873,7 +1288,7 @@ public:
             ::std::is_constructible<T, Args...>::value,
         bool> = true
     >
-    constexpr explicit variant(in_place_type_t<T>, Args&&... args) : variant{_internal::dummy_t{}} {
+    constexpr explicit basic_variant(in_place_type_t<T>, Args&&... args) : basic_variant{_internal::dummy_t{}} {
         _internal::init_alternative_at<_internal::alternative_to_index<0, T, Ts...>::value>(*this, std::forward<Args>(args)...);
     }
 
@@ -884,7 +1299,7 @@ public:
             ::std::is_constructible<T, ::std::initializer_list<U>&, Args...>::value,
         bool> = true
     >
-    constexpr explicit variant(in_place_type_t<T>, ::std::initializer_list<U> il, Args&&... args) : variant{_internal::dummy_t{}} {
+    constexpr explicit basic_variant(in_place_type_t<T>, ::std::initializer_list<U> il, Args&&... args) : basic_variant{_internal::dummy_t{}} {
         _internal::init_alternative_at<_internal::alternative_to_index<0, T, Ts...>::value>(*this, il, std::forward<Args>(args)...);
     }
     
@@ -895,7 +1310,7 @@ public:
             ::std::is_constructible<_internal::index_to_alternative_t<I, Ts...>, Args...>::value,
         bool> = true
     >
-    constexpr explicit variant(in_place_index_t<I>, Args&&... args) : variant{_internal::dummy_t{}} {
+    constexpr explicit basic_variant(in_place_index_t<I>, Args&&... args) : basic_variant{_internal::dummy_t{}} {
         _internal::init_alternative_at<I>(*this, std::forward<Args>(args)...);
     }
     
@@ -906,7 +1321,7 @@ public:
             ::std::is_constructible<_internal::index_to_alternative_t<I, Ts...>, ::std::initializer_list<U>&, Args...>::value,
         bool> = true
     >
-    constexpr explicit variant(in_place_index_t<I>, ::std::initializer_list<U> il, Args&&... args) : variant{_internal::dummy_t{}} {
+    constexpr explicit basic_variant(in_place_index_t<I>, ::std::initializer_list<U> il, Args&&... args) : basic_variant{_internal::dummy_t{}} {
         _internal::init_alternative_at<I>(*this, il, std::forward<Args>(args)...);
     }
     
@@ -914,14 +1329,14 @@ public:
         typename T,
         typename Compat_Ctor_T = _internal::variant_ctor_compat_t<T, Ts...>, // same msvc issue as in a ctor
         ::std::enable_if_t<
-            !::std::is_same<remove_cvref_t<T>, variant>::value,
+            !::std::is_same<remove_cvref_t<T>, basic_variant>::value,
         bool> = true,
         ::std::enable_if_t<
             ::std::is_assignable<Compat_Ctor_T&, T>::value &&
             ::std::is_constructible<Compat_Ctor_T, T>::value,
         bool> = true
     >
-    constexpr variant& operator=(T&& t) noexcept(
+    constexpr basic_variant& operator=(T&& t) noexcept(
         ::std::is_nothrow_assignable<Compat_Ctor_T&, T>::value &&
         ::std::is_nothrow_constructible<Compat_Ctor_T, T>::value
     )
@@ -968,13 +1383,10 @@ public:
             ::std::is_constructible<_internal::index_to_alternative_t<I, Ts...>, Args...>::value,
         bool> = true
     >
-    constexpr variant_alternative_t<I, variant<Ts...>>& emplace(Args&&... args) {
+    constexpr variant_alternative_t<I, basic_variant>& emplace(Args&&... args) {
         static_assert(I < sizeof...(Ts), "I is required to be less than the alternative count");
-        if (this->_index != variant_npos) {
-            _internal::visit_impl(_internal::destroy_alternative{}, this->_index, this->_storage);
-            this->_index = variant_npos;
-        }
-        return *_internal::init_alternative_at<I>(*this, std::forward<Args>(args)...);
+        IDYM_INTERNAL_INSTRUMENT(basic_variant, emplace, I);
+        return emplace_impl<I>(::std::integral_constant<bool, Never_Valueless>{}, ::std::forward<Args>(args)...);
     }
     
     template<
@@ -985,34 +1397,66 @@ public:
             ::std::is_constructible<_internal::index_to_alternative_t<I, Ts...>, ::std::initializer_list<U>&, Args...>::value,
         bool> = true
     >
-    constexpr variant_alternative_t<I, variant<Ts...>>& emplace(::std::initializer_list<U> il, Args&&... args) {
+    constexpr variant_alternative_t<I, basic_variant>& emplace(::std::initializer_list<U> il, Args&&... args) {
         static_assert(I < sizeof...(Ts), "I is required to be less than the alternative count");
-        if (this->_index != variant_npos) {
-            _internal::visit_impl(_internal::destroy_alternative{}, this->_index, this->_storage);
-            this->_index = variant_npos;
-        }
-        return *_internal::init_alternative_at<I>(*this, il, ::std::forward<Args>(args)...);
+        IDYM_INTERNAL_INSTRUMENT(basic_variant, emplace, I);
+        return emplace_impl<I>(::std::integral_constant<bool, Never_Valueless>{}, il, ::std::forward<Args>(args)...);
     }
     
     constexpr bool valueless_by_exception() const noexcept {
-        return this->_index == variant_npos;
+        return !Never_Valueless && this->_index == _internal::variant_index_npos<sizeof...(Ts)>;
     }
     constexpr ::std::size_t index() const noexcept {
-        return this->_index;
+        return valueless_by_exception() ? variant_npos : this->_index;
+    }
+    
+    constexpr void swap(basic_variant& rhs) noexcept(conjunction_v<::std::is_nothrow_move_constructible<Ts>...> && conjunction_v<is_nothrow_swappable<Ts>...>) {
+        if (this->_index != rhs._index)
+            swap_relocate(_internal::relocation_kind<basic_variant>{}, rhs);
+        else
+            swap_impl(::std::integral_constant<bool, Never_Valueless>{}, rhs);
+    }
+    
+    constexpr decltype(auto) _internal_base() & {
+        return static_cast<_internal::variant_base<Never_Valueless, Ts...>&>(*this);
+    }
+    constexpr decltype(auto) _internal_base() const & {
+        return static_cast<const _internal::variant_base<Never_Valueless, Ts...>&>(*this);
+    }
+    constexpr decltype(auto) _internal_base() && {
+        return static_cast<_internal::variant_base<Never_Valueless, Ts...>&&>(*this);
+    }
+    constexpr decltype(auto) _internal_base() const && {
+        return static_cast<const _internal::variant_base<Never_Valueless, Ts...>&&>(*this);
     }
     
-    constexpr void swap(variant& rhs) noexcept(conjunction_v<::std::is_nothrow_move_constructible<Ts>...> && conjunction_v<is_nothrow_swappable<Ts>...>) {
-        if (this->_index == variant_npos) {
-            if (rhs._index == variant_npos)
+private:
+    constexpr basic_variant(_internal::dummy_t) : _internal::variant_base_final<Never_Valueless, Ts...>{_internal::dummy_t{}} {}
+
+    template<::std::size_t I, typename... Args>
+    constexpr auto& emplace_impl(::std::false_type, Args&&... args) {
+        if (this->_index != _internal::variant_index_npos<sizeof...(Ts)>) {
+            _internal::destroy_variant_alternative(_internal_base());
+            this->_index = _internal::variant_index_npos<sizeof...(Ts)>;
+        }
+        return *_internal::init_alternative_at<I>(*this, ::std::forward<Args>(args)...);
+    }
+    template<::std::size_t I, typename... Args>
+    constexpr auto& emplace_impl(::std::true_type, Args&&... args) {
+        _internal::replace_alternative<I>(_internal_base(), ::std::forward<Args>(args)...);
+        return *_internal::get_variant_storage<I>::do_get(this->_storage);
+    }
+
+    constexpr void swap_impl(::std::false_type, basic_variant& rhs) {
+        if (valueless_by_exception()) {
+            if (rhs.valueless_by_exception())
                 return;
             
-            _internal::visit_impl(_internal::move_construct_alternative{}, rhs._index, this->_storage, rhs._storage);
-            _internal::visit_impl(_internal::destroy_alternative{}, rhs._index, rhs._storage);
-            ::std::swap(this->_index, rhs._index);
+            relocate_from(rhs);
             return;
         }
 
-        if (rhs._index == variant_npos) {
+        if (rhs.valueless_by_exception()) {
             rhs.swap(*this);
             return;
         }
@@ -1022,32 +1466,43 @@ public:
             return;
         }
         
-        const auto old_lhs_ind = this->_index;
-        const auto old_rhs_ind = rhs._index;
-        
-        variant tmp_rhs{std::move(rhs)};
-        _internal::visit_impl(_internal::move_construct_alternative{}, old_lhs_ind, rhs._storage, this->_storage);
-        rhs._index = old_lhs_ind;
-        
-        _internal::visit_impl(_internal::move_construct_alternative{}, old_rhs_ind, this->_storage, tmp_rhs._storage);
-        this->_index = old_rhs_ind;
+        // every alternative is moved exactly once and its source destroyed right after
+        basic_variant tmp_rhs{_internal::dummy_t{}};
+        tmp_rhs.relocate_from(rhs);
+        rhs.relocate_from(*this);
+        relocate_from(tmp_rhs);
     }
-    
-    constexpr decltype(auto) _internal_base() & {
-        return static_cast<_internal::variant_base<Ts...>&>(*this);
+    // this is valueless, rhs is left valueless
+    constexpr void relocate_from(basic_variant& rhs) {
+        _internal::visit_impl(_internal::relocate_alternative{}, rhs._index, this->_storage, rhs._storage);
+        this->_index = rhs._index;
+        rhs._index = _internal::variant_index_npos<sizeof...(Ts)>;
     }
-    constexpr decltype(auto) _internal_base() const & {
-        return static_cast<const _internal::variant_base<Ts...>&>(*this);
+    constexpr void swap_impl(::std::true_type, basic_variant& rhs) {
+        if (this->_index == rhs._index) {
+            _internal::visit_impl(_internal::swap_alternative{}, this->_index, this->_storage, rhs._storage);
+            return;
+        }
+
+        // every step keeps a valid alternative, moves that throw leave moved-from values behind instead
+        constexpr auto alternatives = ::std::make_index_sequence<sizeof...(Ts)>{};
+        basic_variant tmp_rhs{::std::move(rhs)};
+        _internal::replace_from_variant_dispatch(alternatives, rhs._internal_base(), ::std::move(*this)._internal_base());
+        _internal::replace_from_variant_dispatch(alternatives, _internal_base(), ::std::move(tmp_rhs)._internal_base());
     }
-    constexpr decltype(auto) _internal_base() && {
-        return static_cast<_internal::variant_base<Ts...>&&>(*this);
+
+    // differing indices, the objects are exchanged whole when the alternatives allow it
+    constexpr void swap_relocate(::std::integral_constant<int, 0>, basic_variant& rhs) {
+        const basic_variant tmp{*this};
+        *this = rhs;
+        rhs = tmp;
     }
-    constexpr decltype(auto) _internal_base() const && {
-        return static_cast<const _internal::variant_base<Ts...>&&>(*this);
+    constexpr void swap_relocate(::std::integral_constant<int, 1>, basic_variant& rhs) {
+        _internal::swap_object_representations(*this, rhs);
+    }
+    constexpr void swap_relocate(::std::integral_constant<int, 2>, basic_variant& rhs) {
+        swap_impl(::std::integral_constant<bool, Never_Valueless>{}, rhs);
     }
-    
-private:
-    constexpr variant(_internal::dummy_t) : _internal::variant_base_final<Ts...>{_internal::dummy_t{}} {}
 
     template<::std::size_t I, typename T>
     constexpr void assign_impl(::std::true_type, T&& t) {
@@ -1059,84 +1514,149 @@ private:
     }
 };
 
+// === is_trivially_relocatable, propagated from the alternatives
+template<bool Never_Valueless, typename... Ts>
+struct is_trivially_relocatable<basic_variant<Never_Valueless, Ts...>> : conjunction<is_trivially_relocatable<::std::remove_cv_t<Ts>>...> {};
+
 // === holds_alternative
-template<typename T, typename... Ts>
-constexpr bool holds_alternative(const variant<Ts...>& v) noexcept {
-    static_assert(_internal::type_occurrence_count<T, Ts...>::value == 1, "T has to occur in Ts exactly once");
-    return !v.valueless_by_exception() && v.index() == _internal::alternative_to_index<0, T, Ts...>::value;
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr bool holds_alternative(const basic_variant<Never_Valueless, Ts...>& v) noexcept {
+    using lookup_t = _internal::boxed_lookup<T, Ts...>;
+    static_assert(lookup_t::count == 1, "T has to occur in Ts exactly once");
+    return !v.valueless_by_exception() && v.index() == lookup_t::index;
 }
 
 // === get<I>
-template<::std::size_t I, typename... Ts>
-constexpr variant_alternative_t<I, variant<Ts...>>& get(variant<Ts...>& v) {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>& get(basic_variant<Never_Valueless, Ts...>& v) {
     return *_internal::get_impl<I>(v._internal_base());
 }
-template<::std::size_t I, typename... Ts>
-constexpr variant_alternative_t<I, variant<Ts...>>&& get(variant<Ts...>&& v) {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>&& get(basic_variant<Never_Valueless, Ts...>&& v) {
     return ::std::move(*_internal::get_impl<I>(v._internal_base()));
 }
-template<::std::size_t I, typename... Ts>
-constexpr const variant_alternative_t<I, variant<Ts...>>& get(const variant<Ts...>& v) {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>& get(const basic_variant<Never_Valueless, Ts...>& v) {
     return *_internal::get_impl<I>(v._internal_base());
 }
-template<::std::size_t I, typename... Ts>
-constexpr const variant_alternative_t<I, variant<Ts...>>&& get(const variant<Ts...>&& v) {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>&& get(const basic_variant<Never_Valueless, Ts...>&& v) {
     return ::std::move(*_internal::get_impl<I>(v._internal_base()));
 }
 
 // === get<T>
-template<typename T, typename... Ts>
-constexpr T& get(variant<Ts...>& v) {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr T& get(basic_variant<Never_Valueless, Ts...>& v) {
     return *_internal::get_impl<T>(v._internal_base());
 }
-template<typename T, typename... Ts>
-constexpr T&& get(variant<Ts...>&& v) {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr T&& get(basic_variant<Never_Valueless, Ts...>&& v) {
     return ::std::move(*_internal::get_impl<T>(v._internal_base()));
 }
-template<typename T, typename... Ts>
-constexpr const T& get(const variant<Ts...>& v) {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr const T& get(const basic_variant<Never_Valueless, Ts...>& v) {
     return *_internal::get_impl<T>(v._internal_base());
 }
-template<typename T, typename... Ts>
-constexpr const T&& get(const variant<Ts...>&& v) {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr const T&& get(const basic_variant<Never_Valueless, Ts...>&& v) {
     return ::std::move(*_internal::get_impl<T>(v._internal_base()));
 }
 
 // === get_if<I>
-template<::std::size_t I, typename... Ts>
-constexpr ::std::add_pointer_t<variant_alternative_t<I, variant<Ts...>>> get_if(variant<Ts...>* v) noexcept {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>> get_if(basic_variant<Never_Valueless, Ts...>* v) noexcept {
     return v ? _internal::get_if_impl<I>(v->_internal_base()) : nullptr;
 }
-template<::std::size_t I, typename... Ts>
-constexpr ::std::add_pointer_t<const variant_alternative_t<I, variant<Ts...>>> get_if(const variant<Ts...>* v) noexcept {
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>> get_if(const basic_variant<Never_Valueless, Ts...>* v) noexcept {
     return v ? _internal::get_if_impl<I>(v->_internal_base()) : nullptr;
 }
 
 // === get_if<T>
-template<typename T, typename... Ts>
-constexpr ::std::add_pointer_t<T> get_if(variant<Ts...>* v) noexcept {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<T> get_if(basic_variant<Never_Valueless, Ts...>* v) noexcept {
     return v ? _internal::get_if_impl<T>(v->_internal_base()) : nullptr;
 }
-template<typename T, typename... Ts>
-constexpr ::std::add_pointer_t<const T> get_if(const variant<Ts...>* v) noexcept {
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<const T> get_if(const basic_variant<Never_Valueless, Ts...>* v) noexcept {
     return v ? _internal::get_if_impl<T>(v->_internal_base()) : nullptr;
 }
 
+// === get_unchecked<I>, the variant has to hold I
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>& get_unchecked(basic_variant<Never_Valueless, Ts...>& v) noexcept {
+    return *_internal::get_unchecked_impl<I>(v._internal_base());
+}
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>&& get_unchecked(basic_variant<Never_Valueless, Ts...>&& v) noexcept {
+    return ::std::move(*_internal::get_unchecked_impl<I>(v._internal_base()));
+}
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>& get_unchecked(const basic_variant<Never_Valueless, Ts...>& v) noexcept {
+    return *_internal::get_unchecked_impl<I>(v._internal_base());
+}
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>&& get_unchecked(const basic_variant<Never_Valueless, Ts...>&& v) noexcept {
+    return ::std::move(*_internal::get_unchecked_impl<I>(v._internal_base()));
+}
+
+// === get_unchecked<T>, the variant has to hold T
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr T& get_unchecked(basic_variant<Never_Valueless, Ts...>& v) noexcept {
+    return *_internal::get_unchecked_impl<T>(v._internal_base());
+}
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr T&& get_unchecked(basic_variant<Never_Valueless, Ts...>&& v) noexcept {
+    return ::std::move(*_internal::get_unchecked_impl<T>(v._internal_base()));
+}
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr const T& get_unchecked(const basic_variant<Never_Valueless, Ts...>& v) noexcept {
+    return *_internal::get_unchecked_impl<T>(v._internal_base());
+}
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr const T&& get_unchecked(const basic_variant<Never_Valueless, Ts...>&& v) noexcept {
+    return ::std::move(*_internal::get_unchecked_impl<T>(v._internal_base()));
+}
+
+// === get_if_unchecked<I>, v has to be non-null and hold I
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>> get_if_unchecked(basic_variant<Never_Valueless, Ts...>* v) noexcept {
+    IDYM_INTERNAL_ASSERT(v != nullptr, "Variant pointer has to be non-null");
+    return _internal::get_unchecked_impl<I>(v->_internal_base());
+}
+template<::std::size_t I, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<const variant_alternative_t<I, basic_variant<Never_Valueless, Ts...>>> get_if_unchecked(const basic_variant<Never_Valueless, Ts...>* v) noexcept {
+    IDYM_INTERNAL_ASSERT(v != nullptr, "Variant pointer has to be non-null");
+    return _internal::get_unchecked_impl<I>(v->_internal_base());
+}
+
+// === get_if_unchecked<T>, v has to be non-null and hold T
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<T> get_if_unchecked(basic_variant<Never_Valueless, Ts...>* v) noexcept {
+    IDYM_INTERNAL_ASSERT(v != nullptr, "Variant pointer has to be non-null");
+    return _internal::get_unchecked_impl<T>(v->_internal_base());
+}
+template<typename T, bool Never_Valueless, typename... Ts>
+constexpr ::std::add_pointer_t<const T> get_if_unchecked(const basic_variant<Never_Valueless, Ts...>* v) noexcept {
+    IDYM_INTERNAL_ASSERT(v != nullptr, "Variant pointer has to be non-null");
+    return _internal::get_unchecked_impl<T>(v->_internal_base());
+}
+
 // === variant relational ops
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::eq_test<Ts>...>, bool> = true>
-constexpr bool operator==(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::eq_test<Ts>...>, bool> = true>
+constexpr bool operator==(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.index() != w.index())
         return false;
     return v.index() == variant_npos || _internal::visit_impl<bool>(_internal::eq_alternative{}, v.index(), v._internal_base()._storage, w._internal_base()._storage);
 }
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::neq_test<Ts>...>, bool> = true>
-constexpr bool operator!=(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::neq_test<Ts>...>, bool> = true>
+constexpr bool operator!=(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.index() != w.index())
         return true;
     return v.index() != variant_npos && _internal::visit_impl<bool>(_internal::neq_alternative{}, v.index(), v._internal_base()._storage, w._internal_base()._storage);
 }
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::less_test<Ts>...>, bool> = true>
-constexpr bool operator<(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::less_test<Ts>...>, bool> = true>
+constexpr bool operator<(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (w.valueless_by_exception())
         return false;
     if (v.valueless_by_exception())
@@ -1145,8 +1665,8 @@ constexpr bool operator<(const variant<Ts...>& v, const variant<Ts...>& w) {
         return v.index() < w.index();
     return _internal::visit_impl<bool>(_internal::less_alternative{}, v.index(), v._internal_base()._storage, w._internal_base()._storage);
 }
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::greater_test<Ts>...>, bool> = true>
-constexpr bool operator>(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::greater_test<Ts>...>, bool> = true>
+constexpr bool operator>(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.valueless_by_exception())
         return false;
     if (w.valueless_by_exception())
@@ -1155,8 +1675,8 @@ constexpr bool operator>(const variant<Ts...>& v, const variant<Ts...>& w) {
         return v.index() > w.index();
     return _internal::visit_impl<bool>(_internal::greater_alternative{}, v.index(), v._internal_base()._storage, w._internal_base()._storage);
 }
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::leq_test<Ts>...>, bool> = true>
-constexpr bool operator<=(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::leq_test<Ts>...>, bool> = true>
+constexpr bool operator<=(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.valueless_by_exception())
         return true;
     if (w.valueless_by_exception())
@@ -1165,8 +1685,8 @@ constexpr bool operator<=(const variant<Ts...>& v, const variant<Ts...>& w) {
         return v.index() < w.index();
     return _internal::visit_impl<bool>(_internal::leq_alternative{}, v.index(), v._internal_base()._storage, w._internal_base()._storage);
 }
-template<typename... Ts, ::std::enable_if_t<conjunction_v<_internal::geq_test<Ts>...>, bool> = true>
-constexpr bool operator>=(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts, ::std::enable_if_t<conjunction_v<_internal::geq_test<Ts>...>, bool> = true>
+constexpr bool operator>=(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.valueless_by_exception())
         return false;
     if (w.valueless_by_exception())
@@ -1177,8 +1697,8 @@ constexpr bool operator>=(const variant<Ts...>& v, const variant<Ts...>& w) {
 }
 
 #if __cpp_impl_three_way_comparison >= 201907L
-template<typename... Ts> requires(::std::three_way_comparable<Ts> && ...)
-constexpr ::std::common_comparison_category_t<::std::compare_three_way_result_t<Ts>...> operator<=>(const variant<Ts...>& v, const variant<Ts...>& w) {
+template<bool Never_Valueless, typename... Ts> requires(::std::three_way_comparable<Ts> && ...)
+constexpr ::std::common_comparison_category_t<::std::compare_three_way_result_t<Ts>...> operator<=>(const basic_variant<Never_Valueless, Ts...>& v, const basic_variant<Never_Valueless, Ts...>& w) {
     if (v.valueless_by_exception() && w.valueless_by_exception())
         return ::std::strong_ordering::equal;
     if (v.valueless_by_exception())
@@ -1223,9 +1743,50 @@ struct verify_invoke_rets<
 template<typename Visitor_T, typename Expected_T, typename... Arg_Ts>
 struct verify_invoke_rets<Visitor_T, Expected_T, alt_visitor_accumulator<Arg_Ts...>> : ::std::is_same<
     Expected_T,
-    decltype(invoke(::std::declval<Visitor_T>(), ::std::declval<Arg_Ts>()...))
+    decltype(::IDYM_NAMESPACE::invoke(::std::declval<Visitor_T>(), ::std::declval<Arg_Ts>()...))
 > {};
 
+template<typename Visitor, typename... Variants>
+struct visit_deduced_ret {
+    using type = decltype(::IDYM_NAMESPACE::invoke(::std::declval<Visitor>(), get<0>(::std::declval<Variants>())...));
+
+    static_assert(verify_invoke_rets<
+        Visitor,
+        type,
+        alt_visitor_accumulator<>,
+        alt_visitor_arg<::std::make_index_sequence<variant_size_v<remove_cvref_t<Variants>>>, Variants>...
+    >::value, "All invoke results have to match");
+};
+
+// === unboxing_visitor, visitors of variants with boxed alternatives are handed the contents of the boxes
+template<typename Visitor>
+struct unboxing_visitor {
+    constexpr explicit unboxing_visitor(Visitor&& v) noexcept : vis(::std::forward<Visitor>(v)) {}
+
+    Visitor&& vis;
+
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const {
+        return ::IDYM_NAMESPACE::invoke(::std::forward<Visitor>(vis), unbox(::std::forward<Args>(args))...);
+    }
+};
+
+template<typename T>
+struct variant_has_boxed : ::std::false_type {};
+template<bool Never_Valueless, typename... Ts>
+struct variant_has_boxed<basic_variant<Never_Valueless, Ts...>> : disjunction<is_boxed<Ts>...> {};
+
+// other visitors are passed on as they are
+template<typename Visitor, typename... Variants>
+using visit_visitor_t = ::std::conditional_t<
+    disjunction_v<variant_has_boxed<remove_cvref_t<Variants>>...>, unboxing_visitor<Visitor>, Visitor&&
+>;
+
+template<typename Visitor_T, typename Visitor>
+constexpr Visitor_T wrap_visitor(Visitor&& vis) noexcept {
+    return static_cast<Visitor_T>(::std::forward<Visitor>(vis));
+}
+
 } // <<< internal
 
 // === visit
@@ -1235,47 +1796,100 @@ constexpr Ret_T visit(Visitor&& vis, Variants&&... vars) {
     
     using dummy_t = bool[];
     static_cast<void>(dummy_t{(has_valueless = has_valueless || vars.valueless_by_exception())...});
-    if (has_valueless)
-        throw bad_variant_access{};
+    if (has_valueless) {
+#ifdef IDYM_INSTRUMENT
+        static_cast<void>(dummy_t{(vars.valueless_by_exception() ?
+            IDYM_INTERNAL_INSTRUMENT(remove_cvref_t<Variants>, bad_access, variant_npos) : static_cast<void>(0), true)...});
+#endif
+        IDYM_INTERNAL_THROW(bad_variant_access{});
+    }
+#ifdef IDYM_INSTRUMENT
+    static_cast<void>(dummy_t{(IDYM_INTERNAL_INSTRUMENT(remove_cvref_t<Variants>, visit, vars._internal_base()._index), true)...});
+#endif
     
     const ::std::array<::std::size_t, sizeof...(Variants)> indices{vars._internal_base()._index...};
-    return _internal::visit_impl<Ret_T>(::std::forward<Visitor>(vis), indices, ::std::forward<Variants>(vars)._internal_base()._storage...);
+    return _internal::visit_impl<Ret_T>(
+        _internal::wrap_visitor<_internal::visit_visitor_t<Visitor, Variants...>>(::std::forward<Visitor>(vis)),
+        indices, ::std::forward<Variants>(vars)._internal_base()._storage...
+    );
 }
 template<typename Visitor, typename... Variants>
 constexpr decltype(auto) visit(Visitor&& vis, Variants&&... vars) {
-    using ret_t = decltype(invoke(::std::declval<Visitor>(), get<0>(::std::declval<Variants>())...));
-    constexpr bool matching_rets = _internal::verify_invoke_rets<
-        Visitor,
-        ret_t,
-        _internal::alt_visitor_accumulator<>,
-        _internal::alt_visitor_arg<::std::make_index_sequence<variant_size_v<remove_cvref_t<Variants>>>, Variants>...
-    >::value;
-    
-    static_assert(matching_rets, "All invoke results have to match");
-    return visit<ret_t>(::std::forward<Visitor>(vis), ::std::forward<Variants>(vars)...);
+    using ret_t = typename _internal::visit_deduced_ret<_internal::visit_visitor_t<Visitor, Variants...>, Variants...>::type;
+    return ::IDYM_NAMESPACE::visit<ret_t>(::std::forward<Visitor>(vis), ::std::forward<Variants>(vars)...);
+}
+
+// === visit_unchecked, none of the variants may be valueless
+template<typename Ret_T, typename Visitor, typename... Variants>
+constexpr Ret_T visit_unchecked(Visitor&& vis, Variants&&... vars) {
+#ifndef NDEBUG
+    using dummy_t = bool[];
+    static_cast<void>(dummy_t{(IDYM_INTERNAL_ASSERT(!vars.valueless_by_exception(), "Variants can't be valueless"), true)...});
+#endif
+#ifdef IDYM_INSTRUMENT
+    using instrument_dummy_t = bool[];
+    static_cast<void>(instrument_dummy_t{(IDYM_INTERNAL_INSTRUMENT(remove_cvref_t<Variants>, visit, vars._internal_base()._index), true)...});
+#endif
+
+    const ::std::array<::std::size_t, sizeof...(Variants)> indices{vars._internal_base()._index...};
+    return _internal::visit_impl<Ret_T>(
+        _internal::wrap_visitor<_internal::visit_visitor_t<Visitor, Variants...>>(::std::forward<Visitor>(vis)),
+        indices, ::std::forward<Variants>(vars)._internal_base()._storage...
+    );
+}
+template<typename Visitor, typename... Variants>
+constexpr decltype(auto) visit_unchecked(Visitor&& vis, Variants&&... vars) {
+    using ret_t = typename _internal::visit_deduced_ret<_internal::visit_visitor_t<Visitor, Variants...>, Variants...>::type;
+    return ::IDYM_NAMESPACE::visit_unchecked<ret_t>(::std::forward<Visitor>(vis), ::std::forward<Variants>(vars)...);
+}
+
+#ifdef IDYM_INSTRUMENT
+template<bool Never_Valueless, typename... Ts>
+struct instrument_slots<basic_variant<Never_Valueless, Ts...>> : ::std::integral_constant<::std::size_t, sizeof...(Ts) + 1> {};
+#endif
+
+// === visit_likely
+/*
+ * As visit for a single variant, with I as the expected alternative. It's tested for first and the visitor is invoked
+ * for it directly, any other index, valueless included, goes through visit
+ */
+template<::std::size_t I, typename Ret_T, typename Visitor, typename Variant>
+constexpr Ret_T visit_likely(Visitor&& vis, Variant&& var) {
+    static_assert(I < variant_size_v<remove_cvref_t<Variant>>, "I is required to be a valid alternative index");
+
+    if (IDYM_INTERNAL_LIKELY(var._internal_base()._index == I)) {
+        IDYM_INTERNAL_INSTRUMENT(remove_cvref_t<Variant>, visit, I);
+        return ::IDYM_NAMESPACE::invoke(::std::forward<Visitor>(vis), _internal::unbox(::IDYM_NAMESPACE::get_unchecked<I>(::std::forward<Variant>(var))));
+    }
+    return ::IDYM_NAMESPACE::visit<Ret_T>(::std::forward<Visitor>(vis), ::std::forward<Variant>(var));
+}
+template<::std::size_t I, typename Visitor, typename Variant>
+constexpr decltype(auto) visit_likely(Visitor&& vis, Variant&& var) {
+    using ret_t = typename _internal::visit_deduced_ret<_internal::visit_visitor_t<Visitor, Variant>, Variant>::type;
+    return ::IDYM_NAMESPACE::visit_likely<I, ret_t>(::std::forward<Visitor>(vis), ::std::forward<Variant>(var));
 }
 
 namespace _internal { // >>> internal
 
+// disabled specialization, neither constructible nor assignable
 template<typename, typename = void>
-struct variant_hash_base {};
+struct variant_hash_base {
+    variant_hash_base() = delete;
+    variant_hash_base(const variant_hash_base&) = delete;
+    variant_hash_base& operator=(const variant_hash_base&) = delete;
+};
 
-template<typename... Ts>
+template<bool Never_Valueless, typename... Ts>
 struct variant_hash_base<
-    variant<Ts...>,
-    ::std::enable_if_t<
-        conjunction_v<::std::is_copy_constructible<::std::hash<::std::remove_cv_t<Ts>>>...> &&
-        conjunction_v<::std::is_destructible<::std::hash<::std::remove_cv_t<Ts>>>...> &&
-        conjunction_v<::std::is_copy_assignable<::std::hash<::std::remove_cv_t<Ts>>>...> &&
-        conjunction_v<is_swappable<::std::hash<::std::remove_cv_t<Ts>>>...> &&
-        conjunction_v<::std::is_same<::std::size_t, decltype(::std::hash<::std::remove_cv<Ts>>{}(::std::declval<Ts>()))...>>
-    >
+    basic_variant<Never_Valueless, Ts...>,
+    ::std::enable_if_t<conjunction_v<hash_enabled<::std::remove_cv_t<Ts>>...>>
 >
 {
-    constexpr ::std::size_t operator()(const variant<Ts...>& v) const {
+    // the index is mixed in, equal values of different alternatives don't collide
+    constexpr ::std::size_t operator()(const basic_variant<Never_Valueless, Ts...>& v) const {
         if (v.valueless_by_exception())
-            return 0;
-        return visit<::std::size_t>(hash_alternative{}, v);
+            return hash_mix(variant_npos, 0);
+        return hash_mix(v.index(), ::IDYM_NAMESPACE::visit<::std::size_t>(hash_alternative{}, v));
     }
 };
 
@@ -1287,18 +1901,18 @@ struct variant_hash_base<
 namespace std { // >>> std
 
 // === swap
-template<typename... Ts,
+template<bool Never_Valueless, typename... Ts,
     ::std::enable_if_t<
         ::IDYM_NAMESPACE::conjunction_v<::std::is_move_constructible<Ts>...> &&
         ::IDYM_NAMESPACE::conjunction_v<::IDYM_NAMESPACE::is_swappable<Ts...>>,
     bool> = true
 >
-constexpr void swap(::IDYM_NAMESPACE::variant<Ts...>& lhs, ::IDYM_NAMESPACE::variant<Ts...>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+constexpr void swap(::IDYM_NAMESPACE::basic_variant<Never_Valueless, Ts...>& lhs, ::IDYM_NAMESPACE::basic_variant<Never_Valueless, Ts...>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
 
-template<typename... Ts>
-struct hash<::IDYM_NAMESPACE::variant<Ts...>> : ::IDYM_NAMESPACE::_internal::variant_hash_base<::IDYM_NAMESPACE::variant<Ts...>> {};
+template<bool Never_Valueless, typename... Ts>
+struct hash<::IDYM_NAMESPACE::basic_variant<Never_Valueless, Ts...>> : ::IDYM_NAMESPACE::_internal::variant_hash_base<::IDYM_NAMESPACE::basic_variant<Never_Valueless, Ts...>> {};
 
 template<>
 struct hash<::IDYM_NAMESPACE::monostate> {
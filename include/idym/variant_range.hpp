@@ -0,0 +1,101 @@
+#ifndef IDYM_VARIANT_RANGE_H
+#define IDYM_VARIANT_RANGE_H
+
+#include <vector>
+#include <iterator>
+
+#include "variant.hpp"
+
+namespace IDYM_NAMESPACE {
+
+namespace _internal { // >>> internal
+
+// === variant_range_buckets
+/*
+ * Positions of a range grouped by alternative index, a counting sort over the indices.
+ * Bucket I spans [offsets[I]; offsets[I + 1]) of positions, valueless elements land in the last bucket
+ */
+template<::std::size_t Size>
+struct variant_range_buckets {
+    static constexpr ::std::size_t valueless_bucket = Size;
+
+    template<typename It>
+    variant_range_buckets(It first, ::std::size_t count) : offsets(Size + 3), positions(count) {
+        // counted two slots ahead, the scatter then leaves every offset at the start of its bucket
+        for (::std::size_t i = 0; i < count; ++i)
+            ++offsets[bucket_of(first[i]) + 2];
+        for (::std::size_t i = 2; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+        for (::std::size_t i = 0; i < count; ++i)
+            positions[offsets[bucket_of(first[i]) + 1]++] = i;
+    }
+
+    template<typename Var_T>
+    static ::std::size_t bucket_of(const Var_T& v) noexcept {
+        return v.valueless_by_exception() ? valueless_bucket : v._internal_base()._index;
+    }
+
+    const ::std::size_t* begin(::std::size_t bucket) const noexcept {
+        return positions.data() + offsets[bucket];
+    }
+    const ::std::size_t* end(::std::size_t bucket) const noexcept {
+        return positions.data() + offsets[bucket + 1];
+    }
+
+    ::std::vector<::std::size_t> offsets;
+    ::std::vector<::std::size_t> positions;
+};
+
+// === visit_range dispatch, a monomorphic loop per alternative
+template<::std::size_t I, typename Visitor, typename It, ::std::size_t Size>
+void visit_range_bucket(::std::false_type, Visitor& vis, It first, const variant_range_buckets<Size>& buckets) {
+    for (auto pos = buckets.begin(I), end = buckets.end(I); pos != end; ++pos)
+        ::IDYM_NAMESPACE::invoke(vis, unbox(::IDYM_NAMESPACE::get_unchecked<I>(first[*pos])));
+}
+template<::std::size_t I, typename Visitor, typename It, ::std::size_t Size>
+void visit_range_bucket(::std::true_type, Visitor& vis, It first, const variant_range_buckets<Size>& buckets) {
+    for (auto pos = buckets.begin(I), end = buckets.end(I); pos != end; ++pos)
+        ::IDYM_NAMESPACE::invoke(vis, *pos, unbox(::IDYM_NAMESPACE::get_unchecked<I>(first[*pos])));
+}
+
+template<typename Indexed, typename Visitor, typename It, ::std::size_t... Is>
+void visit_range_impl(::std::index_sequence<Is...>, Visitor& vis, It first, It last) {
+    static_assert(
+        ::std::is_base_of<::std::random_access_iterator_tag, typename ::std::iterator_traits<It>::iterator_category>::value,
+        "It is required to be a random access iterator"
+    );
+
+    const variant_range_buckets<sizeof...(Is)> buckets{first, static_cast<::std::size_t>(last - first)};
+    if (buckets.begin(buckets.valueless_bucket) != buckets.end(buckets.valueless_bucket))
+        IDYM_INTERNAL_THROW(bad_variant_access{});
+
+    using dummy_t = bool[];
+    static_cast<void>(dummy_t{(visit_range_bucket<Is>(Indexed{}, vis, first, buckets), true)...});
+}
+
+template<typename It>
+using variant_range_indices = ::std::make_index_sequence<variant_size_v<remove_cvref_t<typename ::std::iterator_traits<It>::reference>>>;
+
+} // <<< internal
+
+// === visit_range
+/*
+ * Visits every element of [first; last) grouped by alternative instead of in range order,
+ * the visitor is invoked from a loop per alternative so the call target doesn't change between elements.
+ * Within an alternative elements are visited in range order. Throws bad_variant_access before visiting anything
+ * if an element is valueless
+ */
+template<typename Visitor, typename It>
+void visit_range(Visitor&& vis, It first, It last) {
+    _internal::visit_range_impl<::std::false_type>(_internal::variant_range_indices<It>{}, vis, first, last);
+}
+
+// === visit_range_indexed, as visit_range with the position of the element in the range passed before the alternative
+template<typename Visitor, typename It>
+void visit_range_indexed(Visitor&& vis, It first, It last) {
+    _internal::visit_range_impl<::std::true_type>(_internal::variant_range_indices<It>{}, vis, first, last);
+}
+
+}
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef IDYM_VARIANT_VECTOR_H
+#define IDYM_VARIANT_VECTOR_H
+
+#include <vector>
+#include <memory>
+#include <cstring>
+
+#include "memory.hpp"
+#include "variant.hpp"
+
+namespace IDYM_NAMESPACE {
+
+namespace _internal { // >>> internal
+
+// === variant_vector_buffer, owns an allocation and destroys the elements constructed in [begin; end) unless released
+template<typename T>
+struct variant_vector_buffer {
+    variant_vector_buffer(::std::size_t capacity, ::std::size_t pos) :
+        data{capacity != 0 ? ::std::allocator<T>{}.allocate(capacity) : nullptr}, capacity{capacity}, begin{pos}, end{pos} {}
+    variant_vector_buffer(const variant_vector_buffer&) = delete;
+    variant_vector_buffer& operator=(const variant_vector_buffer&) = delete;
+    ~variant_vector_buffer() {
+        for (::std::size_t i = begin; i < end; ++i)
+            data[i].~T();
+        if (data != nullptr)
+            ::std::allocator<T>{}.deallocate(data, capacity);
+    }
+
+    T* release() noexcept {
+        T* ret = data;
+        data = nullptr;
+        begin = end;
+        return ret;
+    }
+
+    T* data;
+    ::std::size_t capacity;
+    ::std::size_t begin;
+    ::std::size_t end;
+};
+
+// === variant_vector_pool, contiguous storage of a single alternative, trivially relocatable ones are grown with memcpy
+template<typename T>
+class variant_vector_pool {
+public:
+    variant_vector_pool() = default;
+    variant_vector_pool(const variant_vector_pool& other) {
+        variant_vector_buffer<T> buffer{other._size, 0};
+        copy_elements(::std::is_trivially_copyable<T>{}, other, buffer);
+        _size = other._size;
+        _capacity = buffer.capacity;
+        _data = buffer.release();
+    }
+    variant_vector_pool(variant_vector_pool&& other) noexcept : _data{other._data}, _size{other._size}, _capacity{other._capacity} {
+        other._data = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+    ~variant_vector_pool() {
+        clear();
+        if (_data != nullptr)
+            ::std::allocator<T>{}.deallocate(_data, _capacity);
+    }
+
+    variant_vector_pool& operator=(variant_vector_pool other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(variant_vector_pool& other) noexcept {
+        ::std::swap(_data, other._data);
+        ::std::swap(_size, other._size);
+        ::std::swap(_capacity, other._capacity);
+    }
+
+    ::std::size_t size() const noexcept {
+        return _size;
+    }
+    T* data() noexcept {
+        return _data;
+    }
+    const T* data() const noexcept {
+        return _data;
+    }
+    T& operator[](::std::size_t pos) noexcept {
+        return _data[pos];
+    }
+    const T& operator[](::std::size_t pos) const noexcept {
+        return _data[pos];
+    }
+
+    void reserve(::std::size_t capacity) {
+        if (capacity <= _capacity)
+            return;
+        variant_vector_buffer<T> next{capacity, _size};
+        relocate_into(next);
+        adopt(next);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity)
+            return emplace_back_grow(::std::forward<Args>(args)...);
+        T* ret = ::new (static_cast<void*>(_data + _size)) T(::std::forward<Args>(args)...);
+        ++_size;
+        return *ret;
+    }
+
+    void pop_back() noexcept {
+        _data[--_size].~T();
+    }
+    void clear() noexcept {
+        for (::std::size_t i = 0; i < _size; ++i)
+            _data[i].~T();
+        _size = 0;
+    }
+
+private:
+    // the new element is built before relocating, args may refer to an element of this pool
+    template<typename... Args>
+    T& emplace_back_grow(Args&&... args) {
+        variant_vector_buffer<T> next{_capacity != 0 ? 2 * _capacity : 4, _size};
+        T* ret = ::new (static_cast<void*>(next.data + _size)) T(::std::forward<Args>(args)...);
+        ++next.end;
+        relocate_into(next);
+        adopt(next);
+        ++_size;
+        return *ret;
+    }
+
+    void relocate_into(variant_vector_buffer<T>& next) {
+        relocate_elements(is_trivially_relocatable<T>{}, next);
+    }
+    void relocate_elements(::std::true_type, variant_vector_buffer<T>& next) noexcept {
+        relocate_n(_data, _size, next.data);
+        next.begin = 0;
+    }
+    // back to front, the constructed range of next stays contiguous if a copy throws
+    void relocate_elements(::std::false_type, variant_vector_buffer<T>& next) {
+        for (::std::size_t i = _size; i-- > 0; next.begin = i)
+            ::new (static_cast<void*>(next.data + i)) T(::std::move_if_noexcept(_data[i]));
+        for (::std::size_t i = 0; i < _size; ++i)
+            _data[i].~T();
+    }
+
+    static void copy_elements(::std::true_type, const variant_vector_pool& other, variant_vector_buffer<T>& buffer) noexcept {
+        if (other._size != 0)
+            ::std::memcpy(static_cast<void*>(buffer.data), other._data, other._size * sizeof(T));
+    }
+    static void copy_elements(::std::false_type, const variant_vector_pool& other, variant_vector_buffer<T>& buffer) {
+        for (; buffer.end < other._size; ++buffer.end)
+            ::new (static_cast<void*>(buffer.data + buffer.end)) T(other._data[buffer.end]);
+    }
+
+    void adopt(variant_vector_buffer<T>& next) noexcept {
+        if (_data != nullptr)
+            ::std::allocator<T>{}.deallocate(_data, _capacity);
+        _capacity = next.capacity;
+        _data = next.release();
+    }
+
+    T* _data = nullptr;
+    ::std::size_t _size = 0;
+    ::std::size_t _capacity = 0;
+};
+
+// === variant_vector_pools, a pool per alternative reachable by index
+template<::std::size_t I, typename T>
+struct variant_vector_pool_leaf {
+    variant_vector_pool<T> pool;
+};
+
+template<typename, typename...>
+struct variant_vector_pools;
+template<::std::size_t... Is, typename... Ts>
+struct variant_vector_pools<::std::index_sequence<Is...>, Ts...> : variant_vector_pool_leaf<Is, Ts>... {};
+
+template<::std::size_t I, typename T>
+constexpr variant_vector_pool<T>& variant_vector_pool_at(variant_vector_pool_leaf<I, T>& leaf) noexcept {
+    return leaf.pool;
+}
+template<::std::size_t I, typename T>
+constexpr const variant_vector_pool<T>& variant_vector_pool_at(const variant_vector_pool_leaf<I, T>& leaf) noexcept {
+    return leaf.pool;
+}
+
+// pops the last element of a column unless dismissed, rolls back a partially inserted element
+template<typename Column_T>
+struct variant_vector_pop_guard {
+    ~variant_vector_pop_guard() {
+        if (column != nullptr)
+            column->pop_back();
+    }
+
+    Column_T* column;
+};
+
+} // <<< internal
+
+// === variant_vector
+/*
+ * Sequence of variant<Ts...> values stored partitioned by alternative: every alternative has its own contiguous pool
+ * and elements are located through an index and an offset column. Only a pool's own alternative contributes to its
+ * size, so rare large alternatives don't inflate the common ones. Elements can only be appended or removed from the back.
+ * visit_all and for_each walk the pools directly, grouped by alternative and in insertion order within one
+ */
+template<typename... Ts>
+class variant_vector {
+    static_assert(sizeof...(Ts) > 0, "variant_vector has to have at least one alternative");
+    static_assert(conjunction_v<::std::is_nothrow_destructible<Ts>...>, "All alternatives have to be nothrow destructible");
+
+public:
+    using size_type = ::std::size_t;
+    using variant_type = variant<Ts...>;
+
+    // === capacity
+    size_type size() const noexcept {
+        return _indices.size();
+    }
+    bool empty() const noexcept {
+        return _indices.empty();
+    }
+
+    template<::std::size_t I>
+    size_type count() const noexcept {
+        return pool<I>().size();
+    }
+    template<typename T>
+    size_type count() const noexcept {
+        return count<type_index<T>()>();
+    }
+
+    // reserves the index and offset columns
+    void reserve(size_type capacity) {
+        _indices.reserve(capacity);
+        _offsets.reserve(capacity);
+    }
+    template<::std::size_t I>
+    void reserve(size_type capacity) {
+        pool<I>().reserve(capacity);
+    }
+
+    // === element access
+    ::std::size_t index(size_type pos) const noexcept {
+        return _indices[pos];
+    }
+
+    template<::std::size_t I>
+    variant_alternative_t<I, variant_type>& get(size_type pos) {
+        if (_indices[pos] != I)
+            IDYM_INTERNAL_THROW(bad_variant_access{});
+        return pool<I>()[_offsets[pos]];
+    }
+    template<::std::size_t I>
+    const variant_alternative_t<I, variant_type>& get(size_type pos) const {
+        if (_indices[pos] != I)
+            IDYM_INTERNAL_THROW(bad_variant_access{});
+        return pool<I>()[_offsets[pos]];
+    }
+    template<typename T>
+    T& get(size_type pos) {
+        return get<type_index<T>()>(pos);
+    }
+    template<typename T>
+    const T& get(size_type pos) const {
+        return get<type_index<T>()>(pos);
+    }
+
+    template<::std::size_t I>
+    ::std::add_pointer_t<variant_alternative_t<I, variant_type>> get_if(size_type pos) noexcept {
+        return _indices[pos] == I ? pool<I>().data() + _offsets[pos] : nullptr;
+    }
+    template<::std::size_t I>
+    ::std::add_pointer_t<const variant_alternative_t<I, variant_type>> get_if(size_type pos) const noexcept {
+        return _indices[pos] == I ? pool<I>().data() + _offsets[pos] : nullptr;
+    }
+    template<typename T>
+    ::std::add_pointer_t<T> get_if(size_type pos) noexcept {
+        return get_if<type_index<T>()>(pos);
+    }
+    template<typename T>
+    ::std::add_pointer_t<const T> get_if(size_type pos) const noexcept {
+        return get_if<type_index<T>()>(pos);
+    }
+
+    // === modifiers
+    template<::std::size_t I, typename... Args>
+    variant_alternative_t<I, variant_type>& emplace_back(Args&&... args) {
+        static_assert(I < sizeof...(Ts), "I is required to be less than the alternative count");
+        auto& alt_pool = pool<I>();
+
+        _indices.push_back(static_cast<index_t>(I));
+        _internal::variant_vector_pop_guard<decltype(_indices)> indices_guard{&_indices};
+        _offsets.push_back(alt_pool.size());
+        _internal::variant_vector_pop_guard<decltype(_offsets)> offsets_guard{&_offsets};
+
+        auto& ret = alt_pool.emplace_back(::std::forward<Args>(args)...);
+        indices_guard.column = nullptr;
+        offsets_guard.column = nullptr;
+        return ret;
+    }
+    template<typename T, typename... Args>
+    T& emplace_back(Args&&... args) {
+        return emplace_back<type_index<T>()>(::std::forward<Args>(args)...);
+    }
+
+    void push_back(const variant_type& v) {
+        push_back_impl(::std::make_index_sequence<sizeof...(Ts)>{}, v);
+    }
+    void push_back(variant_type&& v) {
+        push_back_impl(::std::make_index_sequence<sizeof...(Ts)>{}, ::std::move(v));
+    }
+
+    // elements are appended to their pools in order, the last element is always last in its pool
+    void pop_back() noexcept {
+        pop_back_impl(::std::make_index_sequence<sizeof...(Ts)>{});
+    }
+    void clear() noexcept {
+        clear_impl(::std::make_index_sequence<sizeof...(Ts)>{});
+    }
+
+    void swap(variant_vector& other) noexcept {
+        ::std::swap(_pools, other._pools);
+        _indices.swap(other._indices);
+        _offsets.swap(other._offsets);
+    }
+    friend void swap(variant_vector& lhs, variant_vector& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // === traversal
+    template<typename Visitor>
+    void visit_all(Visitor&& vis) {
+        visit_all_impl(::std::make_index_sequence<sizeof...(Ts)>{}, vis, *this);
+    }
+    template<typename Visitor>
+    void visit_all(Visitor&& vis) const {
+        visit_all_impl(::std::make_index_sequence<sizeof...(Ts)>{}, vis, *this);
+    }
+
+    template<::std::size_t I, typename F>
+    void for_each(F&& f) {
+        for_each_impl<I>(f, *this);
+    }
+    template<::std::size_t I, typename F>
+    void for_each(F&& f) const {
+        for_each_impl<I>(f, *this);
+    }
+    template<typename T, typename F>
+    void for_each(F&& f) {
+        for_each_impl<type_index<T>()>(f, *this);
+    }
+    template<typename T, typename F>
+    void for_each(F&& f) const {
+        for_each_impl<type_index<T>()>(f, *this);
+    }
+
+private:
+    using index_t = _internal::variant_index_t<sizeof...(Ts)>;
+
+    template<typename T>
+    static constexpr ::std::size_t type_index() noexcept {
+        static_assert(_internal::type_occurrence_count<T, Ts...>::value == 1, "T has to occur exactly once in Ts");
+        return _internal::alternative_to_index<0, T, Ts...>::value;
+    }
+
+    template<::std::size_t I>
+    auto& pool() noexcept {
+        return _internal::variant_vector_pool_at<I>(_pools);
+    }
+    template<::std::size_t I>
+    const auto& pool() const noexcept {
+        return _internal::variant_vector_pool_at<I>(_pools);
+    }
+
+    template<::std::size_t I, typename Var_T>
+    static void push_back_alternative(variant_vector& self, Var_T&& v) {
+        self.emplace_back<I>(::IDYM_NAMESPACE::get_unchecked<I>(::std::forward<Var_T>(v)));
+    }
+    template<typename Var_T, ::std::size_t... Is>
+    void push_back_impl(::std::index_sequence<Is...>, Var_T&& v) {
+        if (v.valueless_by_exception())
+            IDYM_INTERNAL_THROW(bad_variant_access{});
+
+        using dispatch_ptr_t = void (*)(variant_vector&, Var_T&&);
+        using push_back_dispatch_table = _internal::static_dispatch_table<dispatch_ptr_t, &push_back_alternative<Is, Var_T>...>;
+        push_back_dispatch_table::table[v.index()](*this, ::std::forward<Var_T>(v));
+    }
+
+    template<::std::size_t... Is>
+    void pop_back_impl(::std::index_sequence<Is...>) noexcept {
+        const ::std::size_t last = _indices.back();
+        using dummy_t = bool[];
+        static_cast<void>(dummy_t{(Is == last ? (pool<Is>().pop_back(), true) : false)...});
+        _indices.pop_back();
+        _offsets.pop_back();
+    }
+    template<::std::size_t... Is>
+    void clear_impl(::std::index_sequence<Is...>) noexcept {
+        using dummy_t = bool[];
+        static_cast<void>(dummy_t{(pool<Is>().clear(), true)...});
+        _indices.clear();
+        _offsets.clear();
+    }
+
+    template<::std::size_t I, typename F, typename Self_T>
+    static void for_each_impl(F& f, Self_T& self) {
+        auto& alt_pool = self.template pool<I>();
+        for (::std::size_t i = 0; i < alt_pool.size(); ++i)
+            ::IDYM_NAMESPACE::invoke(f, alt_pool[i]);
+    }
+    template<typename Visitor, typename Self_T, ::std::size_t... Is>
+    static void visit_all_impl(::std::index_sequence<Is...>, Visitor& vis, Self_T& self) {
+        using dummy_t = bool[];
+        static_cast<void>(dummy_t{(for_each_impl<Is>(vis, self), true)...});
+    }
+
+    _internal::variant_vector_pools<::std::make_index_sequence<sizeof...(Ts)>, Ts...> _pools;
+    ::std::vector<index_t> _indices;
+    ::std::vector<::std::size_t> _offsets;
+};
+
+}
+
+#endif
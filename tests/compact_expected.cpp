@@ -0,0 +1,150 @@
+#include <idym/compact_expected.hpp>
+
+#include "idym_test.hpp"
+
+enum class errc : unsigned char {
+    ok,
+    not_found,
+    denied
+};
+
+using compact_t = idym::compact_expected<void, errc, errc::ok>;
+
+namespace compact_expected_layout {
+
+static_assert(sizeof(compact_t) == sizeof(errc), "compact_expected.layout");
+static_assert(std::is_trivially_copyable<compact_t>::value, "compact_expected.layout");
+static_assert(std::is_same<compact_t::rebind<void>, compact_t>::value, "compact_expected.layout");
+static_assert(std::is_same<compact_t::rebind<int>, idym::expected<int, errc>>::value, "compact_expected.layout");
+
+}
+
+namespace compact_expected_cons {
+
+void run_ctors() {
+    {
+        constexpr compact_t ex;
+        static_assert(ex.has_value(), "compact_expected.cons.default");
+        constexpr compact_t ex2{idym::in_place};
+        static_assert(ex2.has_value(), "compact_expected.cons.in_place");
+    }
+    {
+        constexpr compact_t ex{idym::unexpect, errc::denied};
+        static_assert(!ex.has_value() && ex.error() == errc::denied, "compact_expected.cons.unexpect");
+        constexpr compact_t ex2 = idym::unexpected<errc>{errc::not_found};
+        static_assert(!ex2 && ex2.error() == errc::not_found, "compact_expected.cons.unexpected");
+    }
+    {
+        const idym::expected<void, errc> ex1;
+        const idym::expected<void, errc> ex2{idym::unexpect, errc::denied};
+        const compact_t compact1 = ex1;
+        const compact_t compact2 = ex2;
+        idym_test::validate(compact1.has_value(), "compact_expected.cons.expected");
+        idym_test::validate(!compact2.has_value() && compact2.error() == errc::denied, "compact_expected.cons.expected");
+
+        const idym::expected<void, errc> back = compact2;
+        idym_test::validate(!back.has_value() && back.error() == errc::denied, "compact_expected.cons.expected");
+    }
+}
+
+}
+
+namespace compact_expected_assign {
+
+void run_assign() {
+    compact_t ex;
+    ex = idym::unexpected<errc>{errc::denied};
+    idym_test::validate(!ex.has_value() && ex.error() == errc::denied, "compact_expected.assign.unexpected");
+
+    compact_t ex2;
+    ex2.swap(ex);
+    idym_test::validate(ex.has_value() && !ex2.has_value(), "compact_expected.swap");
+    swap(ex, ex2);
+    idym_test::validate(!ex.has_value() && ex2.has_value(), "compact_expected.swap");
+
+    ex.emplace();
+    idym_test::validate(ex.has_value(), "compact_expected.emplace");
+}
+
+}
+
+namespace compact_expected_obs {
+
+void run_obs() {
+    const compact_t ex;
+    const compact_t unex{idym::unexpect, errc::not_found};
+
+    ex.value();
+    *ex;
+    IDYM_VALIDATE_EXCEPTION_GENERIC("compact_expected.obs.value", const idym::bad_expected_access<errc>&, unex.value());
+    idym_test::validate(ex.error_or(errc::denied) == errc::denied, "compact_expected.obs.error_or");
+    idym_test::validate(unex.error_or(errc::denied) == errc::not_found, "compact_expected.obs.error_or");
+}
+
+}
+
+namespace compact_expected_monadic {
+
+void run_monadic() {
+    const compact_t ex;
+    const compact_t unex{idym::unexpect, errc::not_found};
+    {
+        int calls = 0;
+        const auto next = [&calls] { ++calls; return compact_t{idym::unexpect, errc::denied}; };
+
+        const auto ret1 = ex.and_then(next);
+        const auto ret2 = unex.and_then(next);
+        static_assert(std::is_same<decltype(ret1), const compact_t>::value, "compact_expected.monadic.and_then");
+        idym_test::validate(calls == 1, "compact_expected.monadic.and_then");
+        idym_test::validate(ret1.error() == errc::denied && ret2.error() == errc::not_found, "compact_expected.monadic.and_then");
+    }
+    {
+        const auto recover = [](errc e) { return e == errc::not_found ? compact_t{} : compact_t{idym::unexpect, e}; };
+        idym_test::validate(ex.or_else(recover).has_value(), "compact_expected.monadic.or_else");
+        idym_test::validate(unex.or_else(recover).has_value(), "compact_expected.monadic.or_else");
+        idym_test::validate(!compact_t{idym::unexpect, errc::denied}.or_else(recover).has_value(), "compact_expected.monadic.or_else");
+    }
+    {
+        const auto ret1 = ex.transform([] { return 5; });
+        const auto ret2 = unex.transform([] { return 5; });
+        static_assert(std::is_same<decltype(ret1), const idym::expected<int, errc>>::value, "compact_expected.monadic.transform");
+        idym_test::validate(*ret1 == 5 && ret2.error() == errc::not_found, "compact_expected.monadic.transform");
+
+        const auto ret3 = unex.transform([] {});
+        static_assert(std::is_same<decltype(ret3), const compact_t>::value, "compact_expected.monadic.transform");
+        idym_test::validate(ret3.error() == errc::not_found, "compact_expected.monadic.transform");
+    }
+    {
+        const auto ret = unex.transform_error([](errc e) { return static_cast<int>(e); });
+        static_assert(std::is_same<decltype(ret), const idym::expected<void, int>>::value, "compact_expected.monadic.transform_error");
+        idym_test::validate(ret.error() == 1 && ex.transform_error([](errc) { return 0; }).has_value(), "compact_expected.monadic.transform_error");
+    }
+}
+
+}
+
+namespace compact_expected_eq {
+
+void run_eq() {
+    const compact_t ex;
+    const compact_t unex{idym::unexpect, errc::not_found};
+    const idym::expected<void, errc> full_unex{idym::unexpect, errc::not_found};
+
+    idym_test::validate(ex == compact_t{} && ex != unex, "compact_expected.eq");
+    idym_test::validate(unex == full_unex && full_unex == unex, "compact_expected.eq");
+    idym_test::validate(ex != full_unex && full_unex != ex, "compact_expected.eq");
+    idym_test::validate(unex == idym::unexpected<errc>{errc::not_found}, "compact_expected.eq");
+    idym_test::validate(idym::unexpected<errc>{errc::denied} != unex, "compact_expected.eq");
+}
+
+}
+
+int main(int, char**) {
+    compact_expected_cons::run_ctors();
+    compact_expected_assign::run_assign();
+    compact_expected_obs::run_obs();
+    compact_expected_monadic::run_monadic();
+    compact_expected_eq::run_eq();
+
+    return 0;
+}
@@ -1,3 +1,7 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <idym/expected.hpp>
 
 #include "idym_test.hpp"
@@ -556,6 +560,54 @@ void run_16_19() {
         idym_test::validate(ex->value == 30, "expected.object.assign.19");
     }
 }
+// implementation specific, a bytewise copyable old state is backed up by its bytes and the copy is made in place
+void run_trivial_state() {
+    {
+        // a copy and a move through a temporary would leave 124
+        idym::expected<int, value_type2<true>> ex1{5};
+        const idym::expected<int, value_type2<true>> ex2{idym::unexpect};
+
+        ex1 = ex2;
+        idym_test::validate(!ex1.has_value() && ex1.error().value == 123, "expected.object.assign.trivial");
+        ex1 = 7;
+        idym_test::validate(ex1.has_value() && *ex1 == 7, "expected.object.assign.trivial");
+
+        const idym::expected<int, value_type2<true>> ex3{ex2};
+        idym_test::validate(!ex3.has_value() && ex3.error().value == 123, "expected.object.copy.trivial");
+    }
+    {
+        idym::expected<value_type2<true>, int> ex1{idym::unexpect, 5};
+        const idym::expected<value_type2<true>, int> ex2{idym::in_place};
+
+        ex1 = ex2;
+        idym_test::validate(ex1.has_value() && ex1->value == 123, "expected.object.assign.trivial");
+
+        const idym::expected<value_type2<true>, int> ex3{idym::unexpect, 6};
+        const idym::expected<value_type2<true>, int> ex4{ex3};
+        idym_test::validate(!ex4.has_value() && ex4.error() == 6, "expected.object.copy.trivial");
+    }
+    {
+        idym::expected<int, std::string> ex1{5};
+        const idym::expected<int, std::string> ex2{idym::unexpect, "a string past the small buffer"};
+
+        ex1 = ex2;
+        idym_test::validate(!ex1.has_value() && ex1.error() == ex2.error(), "expected.object.assign.trivial");
+    }
+    {
+        struct copy_throws {
+            copy_throws() = default;
+            copy_throws(const copy_throws&) { throw idym_test::test_exception{}; }
+            copy_throws(copy_throws&&) noexcept = default;
+            copy_throws& operator=(const copy_throws&) = default;
+            copy_throws& operator=(copy_throws&&) noexcept = default;
+        };
+        idym::expected<int, copy_throws> ex1{5};
+        const idym::expected<int, copy_throws> ex2{idym::unexpect};
+
+        IDYM_VALIDATE_EXCEPTION("expected.object.assign.trivial", ex1 = ex2);
+        idym_test::validate(ex1.has_value() && *ex1 == 5, "expected.object.assign.trivial");
+    }
+}
 }
 
 // [expected.object.swap]
@@ -903,6 +955,20 @@ void run_25_32() {
         static_assert(std::is_same<idym::remove_cvref_t<decltype(ret2)>, idym::expected<int, long>>::value, "expected.object.monadic.32");
     }
 }
+// std types bring std::invoke in through ADL
+void run_std_types() {
+    const auto size_of = [](const std::string& str) { return idym::expected<std::size_t, std::string>{str.size()}; };
+    const auto recover = [](const std::string& str) { return idym::expected<std::string, std::string>{str + "!"}; };
+
+    const idym::expected<std::string, std::string> value{"abc"};
+    const idym::expected<std::string, std::string> unex{idym::unexpect, "err"};
+
+    idym_test::validate(value.and_then(size_of).value() == 3, "expected.object.monadic.std");
+    idym_test::validate(unex.or_else(recover).value() == "err!", "expected.object.monadic.std");
+    idym_test::validate(value.transform([](const std::string& str) { return str.size(); }).value() == 3, "expected.object.monadic.std");
+    idym_test::validate(unex.transform_error([](const std::string& str) { return str + "?"; }).error() == "err?", "expected.object.monadic.std");
+    IDYM_VALIDATE_EXCEPTION_GENERIC("expected.object.monadic.std", const idym::bad_expected_access<std::string>&, unex.value());
+}
 }
 
 // [expected.object.eq]
@@ -1012,6 +1078,16 @@ void run_5_6() {
         idym_test::validate(value != ex, "expected.object.eq.6");
     }
 }
+// T == T2 must not reach the value comparators through a conversion from T
+void run_containers() {
+    std::vector<idym::expected<int, short>> exs;
+    exs.emplace_back(idym::in_place, 123);
+    exs.emplace_back(idym::unexpect, 124);
+
+    idym_test::validate(exs.begin() != exs.end(), "expected.object.eq.containers");
+    idym_test::validate(exs.front() == 123 && 123 == exs.front(), "expected.object.eq.containers");
+    idym_test::validate(exs.back() != 124 && 124 != exs.back(), "expected.object.eq.containers");
+}
 }
 
 /*
@@ -1637,6 +1713,162 @@ void run_3_4() {
 }
 }
 
+// implementation specific, error state encoded in the value bytes
+struct niche_id {
+    std::uint32_t value;
+    std::uint32_t tag; // never all ones
+};
+// counts into a static, a pointer member past the niche would be left uninitialized in the error state
+struct counted_niche_id {
+    counted_niche_id(std::uint32_t value) noexcept : value{value} {}
+    counted_niche_id(const counted_niche_id& other) noexcept : value{other.value + 1}, tag{other.tag} {}
+    ~counted_niche_id() { ++dtor_count; }
+
+    counted_niche_id& operator=(const counted_niche_id& other) noexcept {
+        value = other.value + 2;
+        tag = other.tag;
+        return *this;
+    }
+
+    static int dtor_count;
+    std::uint32_t value;
+    std::uint32_t tag = 0; // never all ones
+};
+int counted_niche_id::dtor_count = 0;
+
+// writes over the niche before throwing, from a nonzero value or on a copy
+struct throwing_niche_id {
+    throwing_niche_id(long v) : value{v}, tag{v} {
+        if (v != 0)
+            throw idym_test::test_exception{};
+    }
+    throwing_niche_id(const throwing_niche_id& other) : value{other.value}, tag{other.tag} {
+        throw idym_test::test_exception{};
+    }
+    throwing_niche_id(throwing_niche_id&&) noexcept = default;
+    throwing_niche_id& operator=(const throwing_niche_id&) = default;
+    throwing_niche_id& operator=(throwing_niche_id&&) noexcept = default;
+
+    long value;
+    long tag; // never all ones
+};
+
+namespace idym {
+template<>
+struct expected_niche<throwing_niche_id> : expected_pattern_niche<sizeof(long), 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff> {};
+template<>
+struct expected_niche<niche_id> : expected_pattern_niche<4, 0xff, 0xff, 0xff, 0xff> {};
+template<>
+struct expected_niche<counted_niche_id> : expected_pattern_niche<sizeof(std::uint32_t), 0xff, 0xff, 0xff, 0xff> {};
+}
+
+namespace expected_niche {
+
+static_assert(sizeof(idym::expected<niche_id, int>) == sizeof(niche_id), "expected.niche.layout");
+static_assert(sizeof(idym::expected<niche_id, short>) == sizeof(niche_id), "expected.niche.layout");
+static_assert(sizeof(idym::expected<niche_id, std::uint64_t>) > sizeof(niche_id), "expected.niche.layout");
+static_assert(sizeof(idym::expected<int, niche_id>) > sizeof(niche_id), "expected.niche.layout");
+
+void run_trivial() {
+    using expected_t = idym::expected<niche_id, int>;
+    {
+        expected_t ex1{niche_id{1, 2}};
+        expected_t ex2{idym::unexpect, 3};
+        idym_test::validate(ex1.has_value() && ex1->value == 1 && ex1->tag == 2, "expected.niche.ctor");
+        idym_test::validate(!ex2.has_value() && ex2.error() == 3, "expected.niche.ctor");
+
+        const expected_t ex3{ex2};
+        idym_test::validate(!ex3.has_value() && ex3.error() == 3, "expected.niche.copy");
+
+        ex1.swap(ex2);
+        idym_test::validate(!ex1.has_value() && ex1.error() == 3, "expected.niche.swap");
+        idym_test::validate(ex2.has_value() && ex2->value == 1, "expected.niche.swap");
+
+        ex1 = ex2;
+        idym_test::validate(ex1.has_value() && ex1->tag == 2, "expected.niche.assign");
+        ex1 = idym::unexpected<int>{4};
+        idym_test::validate(!ex1.has_value() && ex1.error() == 4, "expected.niche.assign");
+        ex1.emplace(niche_id{5, 6});
+        idym_test::validate(ex1.has_value() && ex1->value == 5, "expected.niche.emplace");
+
+        const auto ret = ex3.transform_error([](int e) { return static_cast<short>(e + 1); });
+        idym_test::validate(!ret.has_value() && ret.error() == 4, "expected.niche.monadic");
+    }
+}
+
+void run_nontrivial() {
+    using expected_t = idym::expected<counted_niche_id, int>;
+    static_assert(sizeof(expected_t) == sizeof(counted_niche_id), "expected.niche.layout");
+
+    int& dtor_count = counted_niche_id::dtor_count;
+    dtor_count = 0;
+    {
+        expected_t ex1{idym::in_place, 1u};
+        expected_t ex2{idym::unexpect, 2};
+
+        expected_t ex3{ex1};
+        idym_test::validate(ex3.has_value() && ex3->value == 2, "expected.niche.copy");
+
+        ex3 = ex2;
+        idym_test::validate(dtor_count == 1, "expected.niche.assign");
+        idym_test::validate(!ex3.has_value() && ex3.error() == 2, "expected.niche.assign");
+
+        ex3 = ex1;
+        idym_test::validate(ex3.has_value() && ex3->value == 2, "expected.niche.assign");
+
+        ex3.swap(ex2);
+        idym_test::validate(!ex3.has_value() && ex3.error() == 2, "expected.niche.swap");
+        idym_test::validate(ex2.has_value(), "expected.niche.swap");
+
+        dtor_count = 0;
+        ex2 = idym::unexpected<int>{5};
+        idym_test::validate(dtor_count == 1 && !ex2.has_value() && ex2.error() == 5, "expected.niche.assign");
+    }
+    idym_test::validate(dtor_count == 2, "expected.niche.dtor");
+}
+
+// a construction throwing after writing over the niche leaves the error state in place
+void run_failed_reinit() {
+    using expected_t = idym::expected<throwing_niche_id, int>;
+    static_assert(sizeof(expected_t) == sizeof(throwing_niche_id), "expected.niche.layout");
+
+    expected_t ex1{idym::unexpect, 7};
+    IDYM_VALIDATE_EXCEPTION("expected.niche.reinit", ex1 = 3);
+    idym_test::validate(!ex1.has_value() && ex1.error() == 7, "expected.niche.reinit");
+
+    const expected_t ex2{idym::in_place, 0};
+    IDYM_VALIDATE_EXCEPTION("expected.niche.reinit", ex1 = ex2);
+    idym_test::validate(!ex1.has_value() && ex1.error() == 7, "expected.niche.reinit");
+}
+
+}
+
+// implementation specific, std::hash specializations
+namespace expected_hash {
+
+struct not_hashable {};
+
+static_assert(std::is_default_constructible<std::hash<idym::expected<int, std::string>>>::value, "expected.hash");
+static_assert(std::is_default_constructible<std::hash<idym::expected<void, int>>>::value, "expected.hash");
+static_assert(!std::is_default_constructible<std::hash<idym::expected<not_hashable, int>>>::value, "expected.hash");
+static_assert(!std::is_default_constructible<std::hash<idym::expected<void, not_hashable>>>::value, "expected.hash");
+
+void run_hash() {
+    using ex_t = idym::expected<int, int>;
+    const std::hash<ex_t> hasher{};
+
+    idym_test::validate(hasher(ex_t{3}) == hasher(ex_t{3}), "expected.hash");
+    idym_test::validate(hasher(ex_t{3}) != hasher(ex_t{idym::unexpect, 3}), "expected.hash.flag");
+    idym_test::validate(hasher(ex_t{idym::unexpect, 3}) != hasher(ex_t{idym::unexpect, 4}), "expected.hash");
+
+    using void_t = idym::expected<void, std::string>;
+    const std::hash<void_t> void_hasher{};
+    idym_test::validate(void_hasher(void_t{}) == void_hasher(void_t{}), "expected.hash");
+    idym_test::validate(void_hasher(void_t{}) != void_hasher(void_t{idym::unexpect}), "expected.hash.flag");
+}
+
+}
+
 int main(int, char**) {
     expected_un_cons::run_1_9();
     expected_un_obs::run_1_2();
@@ -1654,6 +1886,7 @@ int main(int, char**) {
     expected_object_assign::run_2_8();
     expected_object_assign::run_9_15();
     expected_object_assign::run_16_19();
+    expected_object_assign::run_trivial_state();
     
     expected_object_swap::run_1_5();
 
@@ -1668,10 +1901,12 @@ int main(int, char**) {
     expected_object_monadic::run_9_16();
     expected_object_monadic::run_17_24();
     expected_object_monadic::run_25_32();
+    expected_object_monadic::run_std_types();
 
     expected_object_eq::run_1_2();
     expected_object_eq::run_3_4();
     expected_object_eq::run_5_6();
+    expected_object_eq::run_containers();
 
     expected_void_cons::run_1();
     expected_void_cons::run_2_6();
@@ -1701,5 +1936,11 @@ int main(int, char**) {
     expected_void_eq::run_1_2();
     expected_void_eq::run_3_4();
 
+    expected_niche::run_trivial();
+    expected_niche::run_nontrivial();
+    expected_niche::run_failed_reinit();
+
+    expected_hash::run_hash();
+
     return 0;
 }
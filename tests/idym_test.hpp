@@ -4,6 +4,8 @@
 #include <cassert>
 #include <iostream>
 
+#include <idym/idym_defs.hpp>
+
 #define IDYM_VALIDATE_EXCEPTION_GENERIC(STR, EXCEPTION_TYPE, ...) \
     do { \
         bool caught = false; \
@@ -31,9 +33,11 @@ struct ndef_ctor {
 struct def_ctor {
     int value = 1337;
 };
+#ifndef IDYM_NO_EXCEPTIONS
 struct def_ctor_throws {
     def_ctor_throws() { throw test_exception{}; }
 };
+#endif
 
 struct copy_ctor {
     copy_ctor() = default;
@@ -41,10 +45,12 @@ struct copy_ctor {
     
     int value = 0;
 };
+#ifndef IDYM_NO_EXCEPTIONS
 struct copy_ctor_throws {
     copy_ctor_throws() = default;
     copy_ctor_throws(const copy_ctor_throws&) { throw idym_test::test_exception{}; }
 };
+#endif
 struct ncopy_ctor {
     ncopy_ctor(const ncopy_ctor&) = delete;
 };
@@ -55,10 +61,12 @@ struct move_ctor {
     
     int value{};
 };
+#ifndef IDYM_NO_EXCEPTIONS
 struct move_ctor_throws {
     move_ctor_throws() = default;
     move_ctor_throws(move_ctor_throws&&) { throw idym_test::test_exception{}; }
 };
+#endif
 struct nmove_ctor {
     nmove_ctor(nmove_ctor&&) = delete;
 };
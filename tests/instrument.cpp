@@ -0,0 +1,142 @@
+#include <string>
+#include <vector>
+
+#include <idym/variant.hpp>
+#include <idym/expected.hpp>
+#include <idym/compact_expected.hpp>
+
+#include "idym_test.hpp"
+
+#ifndef IDYM_INSTRUMENT
+  #error "expected to be built with instrumentation enabled"
+#endif
+
+using var_t = idym::variant<int, std::string>;
+using var_counters = idym::instrument_counters<var_t>;
+
+namespace instrument_variant {
+
+void run_counters() {
+    static_assert(var_counters::slots == 3, "instrument.variant.slots");
+    var_counters::reset();
+
+    var_t v{1};
+    idym_test::validate(idym::get<0>(v) == 1, "instrument.variant.get");
+    idym_test::validate(var_counters::count(idym::instrument_event::get, 0) == 1, "instrument.variant.get");
+
+    v.emplace<1>("one");
+    v.emplace<std::string>("two");
+    idym_test::validate(var_counters::count(idym::instrument_event::emplace, 1) == 2, "instrument.variant.emplace");
+    idym_test::validate(var_counters::count(idym::instrument_event::emplace, 0) == 0, "instrument.variant.emplace");
+
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.variant.bad_access", idym::bad_variant_access, idym::get<int>(v));
+    idym_test::validate(var_counters::count(idym::instrument_event::get, 1) == 1, "instrument.variant.bad_access");
+    idym_test::validate(var_counters::count(idym::instrument_event::bad_access, 1) == 1, "instrument.variant.bad_access");
+
+    const auto size = [](const auto& alt) { return sizeof(alt); };
+    idym::visit(size, v);
+    idym::visit_unchecked(size, v);
+    idym::visit_likely<1>(size, v);
+    idym::visit_likely<0>(size, v);
+    idym_test::validate(var_counters::count(idym::instrument_event::visit, 1) == 4, "instrument.variant.visit");
+
+    var_t w{2};
+    w = v;
+    w = var_t{3};
+    idym_test::validate(var_counters::count(idym::instrument_event::assign, 1) == 1, "instrument.variant.assign");
+    idym_test::validate(var_counters::count(idym::instrument_event::assign, 0) == 1, "instrument.variant.assign");
+
+    var_counters::reset();
+    idym_test::validate(var_counters::count(idym::instrument_event::visit, 1) == 0, "instrument.variant.reset");
+}
+
+void run_valueless() {
+    struct throws_on_move {
+        throws_on_move() = default;
+        throws_on_move(const throws_on_move&) = default;
+        throws_on_move(throws_on_move&&) { throw idym_test::test_exception{}; }
+        throws_on_move& operator=(const throws_on_move&) = default;
+        throws_on_move& operator=(throws_on_move&&) = default;
+    };
+    using throwing_var_t = idym::variant<int, throws_on_move>;
+    using counters = idym::instrument_counters<throwing_var_t>;
+
+    throwing_var_t v;
+    IDYM_VALIDATE_EXCEPTION("instrument.variant.valueless", v = throws_on_move{});
+    idym_test::validate(v.valueless_by_exception(), "instrument.variant.valueless");
+
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.variant.valueless", idym::bad_variant_access, idym::visit([](const auto&) {}, v));
+    idym_test::validate(counters::count(idym::instrument_event::bad_access, 2) == 1, "instrument.variant.valueless");
+    idym_test::validate(counters::count(idym::instrument_event::visit, 2) == 0, "instrument.variant.valueless");
+}
+
+}
+
+namespace instrument_expected {
+
+void run_counters() {
+    using ex_t = idym::expected<int, int>;
+    using void_ex_t = idym::expected<void, int>;
+    using compact_t = idym::compact_expected<void, int, 0>;
+
+    const ex_t ex{5};
+    const ex_t unex{idym::unexpect, 7};
+    idym_test::validate(ex.value() == 5, "instrument.expected.value");
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.expected.value", idym::bad_expected_access<int>, unex.value());
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.expected.value", idym::bad_expected_access<int>, ex_t{unex}.value());
+
+    using counters = idym::instrument_counters<ex_t>;
+    idym_test::validate(counters::count(idym::instrument_event::value, 0) == 1, "instrument.expected.value");
+    idym_test::validate(counters::count(idym::instrument_event::value, 1) == 2, "instrument.expected.value");
+    idym_test::validate(counters::count(idym::instrument_event::bad_access, 1) == 2, "instrument.expected.value");
+
+    void_ex_t{}.value();
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.expected.void", idym::bad_expected_access<int>, void_ex_t{idym::unexpect, 1}.value());
+    idym_test::validate(idym::instrument_counters<void_ex_t>::count(idym::instrument_event::value, 0) == 1, "instrument.expected.void");
+    idym_test::validate(idym::instrument_counters<void_ex_t>::count(idym::instrument_event::bad_access, 1) == 1, "instrument.expected.void");
+
+    IDYM_VALIDATE_EXCEPTION_GENERIC("instrument.compact_expected", idym::bad_expected_access<int>, compact_t{idym::unexpect, 1}.value());
+    idym_test::validate(idym::instrument_counters<compact_t>::count(idym::instrument_event::bad_access, 1) == 1, "instrument.compact_expected");
+}
+
+}
+
+namespace instrument_sink {
+
+struct record {
+    idym::instrument_event event;
+    const void* type_key;
+    std::size_t slot;
+};
+std::vector<record> records;
+
+void record_sink(idym::instrument_event event, const void* type_key, std::size_t slot) {
+    records.push_back({event, type_key, slot});
+}
+
+void run_sink() {
+    var_counters::reset();
+    idym_test::validate(idym::get_instrument_sink() == nullptr, "instrument.sink");
+    idym_test::validate(idym::set_instrument_sink(record_sink) == nullptr, "instrument.sink");
+
+    var_t v{std::string{"str"}};
+    idym::get<1>(v);
+    idym::set_instrument_sink(nullptr);
+
+    idym_test::validate(records.size() == 1, "instrument.sink");
+    idym_test::validate(records[0].event == idym::instrument_event::get, "instrument.sink");
+    idym_test::validate(records[0].type_key == var_counters::key(), "instrument.sink");
+    idym_test::validate(records[0].slot == 1, "instrument.sink");
+    idym_test::validate(var_counters::count(idym::instrument_event::get, 1) == 0, "instrument.sink");
+}
+
+}
+
+int main(int, char**) {
+    instrument_variant::run_counters();
+    instrument_variant::run_valueless();
+    instrument_expected::run_counters();
+    instrument_sink::run_sink();
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include <memory>
+#include <string>
+
+#include <idym/memory.hpp>
+#include <idym/variant.hpp>
+#include <idym/expected.hpp>
+
+#include "idym_test.hpp"
+
+// owns a pointer to itself, never relocatable
+struct self_referencing {
+    self_referencing() : self{this} {}
+    self_referencing(const self_referencing&) : self{this} {}
+    self_referencing& operator=(const self_referencing&) { return *this; }
+
+    self_referencing* self;
+};
+
+// counts destructions, opts in
+struct counted_relocatable {
+    counted_relocatable(int v) : value{v} {}
+    counted_relocatable(counted_relocatable&& other) noexcept : value{other.value} { ++move_count; }
+    ~counted_relocatable() { ++dtor_count; }
+
+    static int move_count;
+    static int dtor_count;
+    int value;
+};
+int counted_relocatable::move_count = 0;
+int counted_relocatable::dtor_count = 0;
+
+namespace idym {
+template<>
+struct is_trivially_relocatable<counted_relocatable> : std::true_type {};
+}
+
+namespace memory_trait {
+
+static_assert(idym::is_trivially_relocatable_v<int>, "memory.is_trivially_relocatable");
+static_assert(idym::is_trivially_relocatable_v<std::unique_ptr<int>>, "memory.is_trivially_relocatable");
+static_assert(idym::is_trivially_relocatable_v<counted_relocatable>, "memory.is_trivially_relocatable");
+static_assert(!idym::is_trivially_relocatable_v<self_referencing>, "memory.is_trivially_relocatable");
+
+static_assert(idym::is_trivially_relocatable_v<idym::variant<int, std::unique_ptr<int>>>, "memory.is_trivially_relocatable.variant");
+static_assert(idym::is_trivially_relocatable_v<idym::never_valueless_variant<int, const counted_relocatable>>, "memory.is_trivially_relocatable.variant");
+static_assert(!idym::is_trivially_relocatable_v<idym::variant<int, self_referencing>>, "memory.is_trivially_relocatable.variant");
+
+static_assert(idym::is_trivially_relocatable_v<idym::expected<std::unique_ptr<int>, int>>, "memory.is_trivially_relocatable.expected");
+static_assert(idym::is_trivially_relocatable_v<idym::expected<void, counted_relocatable>>, "memory.is_trivially_relocatable.expected");
+static_assert(!idym::is_trivially_relocatable_v<idym::expected<int, self_referencing>>, "memory.is_trivially_relocatable.expected");
+
+}
+
+namespace memory_relocate {
+
+template<typename T>
+struct raw_storage {
+    T* data() { return reinterpret_cast<T*>(bytes); }
+    alignas(T) unsigned char bytes[4 * sizeof(T)];
+};
+
+void run_relocate_n() {
+    {
+        raw_storage<counted_relocatable> source;
+        raw_storage<counted_relocatable> dest;
+        for (int i = 0; i < 4; ++i)
+            ::new (static_cast<void*>(source.data() + i)) counted_relocatable{i};
+
+        counted_relocatable* end = idym::relocate_n(source.data(), 4, dest.data());
+        idym_test::validate(end == dest.data() + 4, "memory.relocate_n");
+        idym_test::validate(dest.data()[0].value == 0 && dest.data()[3].value == 3, "memory.relocate_n");
+        idym_test::validate(counted_relocatable::move_count == 0 && counted_relocatable::dtor_count == 0, "memory.relocate_n.trivial");
+
+        idym::relocate(dest.data() + 3, source.data());
+        idym_test::validate(source.data()->value == 3 && counted_relocatable::dtor_count == 0, "memory.relocate");
+        
+        source.data()->~counted_relocatable();
+        for (int i = 0; i < 3; ++i)
+            dest.data()[i].~counted_relocatable();
+        idym_test::validate(counted_relocatable::dtor_count == 4, "memory.relocate_n.trivial");
+    }
+    {
+        raw_storage<std::string> source;
+        raw_storage<std::string> dest;
+        for (int i = 0; i < 4; ++i)
+            ::new (static_cast<void*>(source.data() + i)) std::string(40, static_cast<char>('a' + i));
+
+        idym::relocate_n(source.data(), 4, dest.data());
+        idym_test::validate(dest.data()[0] == std::string(40, 'a') && dest.data()[3] == std::string(40, 'd'), "memory.relocate_n");
+        for (int i = 0; i < 4; ++i)
+            dest.data()[i].~basic_string();
+    }
+}
+
+void run_swap() {
+    {
+        idym::variant<std::unique_ptr<int>, int> v1{std::make_unique<int>(5)};
+        idym::variant<std::unique_ptr<int>, int> v2{3};
+
+        v1.swap(v2);
+        idym_test::validate(idym::get<1>(v1) == 3 && *idym::get<0>(v2) == 5, "memory.swap.variant");
+        v1.swap(v2);
+        idym_test::validate(*idym::get<0>(v1) == 5 && idym::get<1>(v2) == 3, "memory.swap.variant");
+    }
+    {
+        idym::expected<std::unique_ptr<int>, int> ex1{std::make_unique<int>(5)};
+        idym::expected<std::unique_ptr<int>, int> ex2{idym::unexpect, 3};
+
+        ex1.swap(ex2);
+        idym_test::validate(ex1.error() == 3 && **ex2 == 5, "memory.swap.expected");
+        swap(ex1, ex2);
+        idym_test::validate(**ex1 == 5 && ex2.error() == 3, "memory.swap.expected");
+    }
+    {
+        idym::variant<int, float> v1{1};
+        idym::variant<int, float> v2{2.0f};
+        v1.swap(v2);
+        idym_test::validate(idym::get<1>(v1) == 2.0f && idym::get<0>(v2) == 1, "memory.swap.variant");
+    }
+}
+
+}
+
+namespace memory_boxed {
+
+// a stateful allocator counting the live allocations of its arena
+struct arena {
+    int live = 0;
+    int total = 0;
+};
+
+template<typename T>
+struct arena_allocator {
+    using value_type = T;
+
+    arena_allocator() = default;
+    explicit arena_allocator(arena* a) : source{a} {}
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) : source{other.source} {}
+
+    T* allocate(std::size_t n) {
+        ++source->live;
+        ++source->total;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n) {
+        --source->live;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator& rhs) { return lhs.source == rhs.source; }
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator& rhs) { return lhs.source != rhs.source; }
+
+    arena* source = nullptr;
+};
+
+// propagates on every assignment and swap, and can't be default constructed
+template<typename T>
+struct propagating_allocator : arena_allocator<T> {
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit propagating_allocator(arena* a) : arena_allocator<T>{a} {}
+    template<typename U>
+    propagating_allocator(const propagating_allocator<U>& other) : arena_allocator<T>{other.source} {}
+};
+
+static_assert(sizeof(idym::boxed<std::string>) == sizeof(void*), "memory.boxed");
+static_assert(idym::is_trivially_relocatable_v<idym::boxed<std::string>>, "memory.boxed");
+static_assert(std::is_nothrow_move_constructible<idym::boxed<std::string>>::value, "memory.boxed");
+static_assert(std::is_nothrow_move_assignable<idym::boxed<std::string>>::value, "memory.boxed");
+static_assert(!std::is_nothrow_move_assignable<idym::boxed<std::string, arena_allocator<std::string>>>::value, "memory.boxed");
+static_assert(std::is_nothrow_move_assignable<idym::boxed<std::string, propagating_allocator<std::string>>>::value, "memory.boxed");
+static_assert(!std::is_constructible<idym::boxed<std::string, propagating_allocator<std::string>>, const std::string&>::value, "memory.boxed");
+static_assert(!std::is_constructible<idym::boxed<std::string, propagating_allocator<std::string>>, std::string&&>::value, "memory.boxed");
+static_assert(!std::is_default_constructible<idym::boxed<std::string, propagating_allocator<std::string>>>::value, "memory.boxed");
+static_assert(std::is_same<idym::unboxed_t<idym::boxed<int, arena_allocator<int>>>, int>::value, "memory.unboxed");
+static_assert(std::is_same<idym::unboxed_t<int>, int>::value, "memory.unboxed");
+static_assert(std::is_same<idym::boxed_if_larger_t<8, char[9]>, idym::boxed<char[9]>>::value, "memory.boxed_if_larger");
+static_assert(std::is_same<idym::boxed_if_larger_t<8, char[8]>, char[8]>::value, "memory.boxed_if_larger");
+
+struct not_hashable {};
+static_assert(std::is_default_constructible<std::hash<idym::boxed<std::string>>>::value, "memory.boxed.hash");
+static_assert(!std::is_default_constructible<std::hash<idym::boxed<not_hashable>>>::value, "memory.boxed.hash");
+
+void run_boxed() {
+    using box_t = idym::boxed<std::string, arena_allocator<std::string>>;
+    arena a;
+    arena b;
+    {
+        box_t box1{std::allocator_arg, arena_allocator<std::string>{&a}, idym::in_place, 40, 'a'};
+        idym_test::validate(*box1 == std::string(40, 'a') && box1->size() == 40 && a.live == 1, "memory.boxed.ctor");
+
+        box_t box2{box1};
+        idym_test::validate(*box2 == *box1 && box2.get() != box1.get() && a.live == 2, "memory.boxed.copy");
+        idym_test::validate(box1 == box2 && !(box1 < box2), "memory.boxed.relops");
+
+        box_t box3{std::move(box2)};
+        idym_test::validate(!box2 && *box3 == *box1 && a.live == 2, "memory.boxed.move");
+
+        box_t box4{std::allocator_arg, arena_allocator<std::string>{&b}, idym::in_place, "b"};
+        box4 = box3;
+        idym_test::validate(*box4 == *box3 && a.live == 2 && b.live == 1, "memory.boxed.copy_assign");
+        idym_test::validate(box4.get_allocator().source == &b, "memory.boxed.copy_assign");
+        box2 = box4;
+        idym_test::validate(*box2 == *box4 && a.live == 3 && b.live == 1, "memory.boxed.copy_assign");
+        idym_test::validate(box2.get_allocator().source == &a, "memory.boxed.copy_assign");
+
+        // unequal allocators that don't propagate, the string is moved into b
+        box4 = std::move(box1);
+        idym_test::validate(!box1 && *box4 == std::string(40, 'a') && a.live == 2 && b.live == 1, "memory.boxed.move_assign");
+        idym_test::validate(box4.get_allocator().source == &b, "memory.boxed.move_assign");
+        box1 = std::move(box3);
+        idym_test::validate(!box3 && *box1 == std::string(40, 'a') && a.live == 2, "memory.boxed.move_assign");
+
+        swap(box2, box4);
+        idym_test::validate(box2.get_allocator().source == &b && box4.get_allocator().source == &a, "memory.boxed.swap");
+
+        idym_test::validate(std::hash<box_t>{}(box2) == std::hash<std::string>{}(*box2), "memory.boxed.hash");
+    }
+    idym_test::validate(a.live == 0 && b.live == 0 && a.total == 3 && b.total == 1, "memory.boxed.dtor");
+}
+
+void run_boxed_propagate() {
+    using box_t = idym::boxed<std::string, propagating_allocator<std::string>>;
+    arena a;
+    arena b;
+    {
+        box_t box1{std::allocator_arg, propagating_allocator<std::string>{&a}, idym::in_place, "a"};
+        box_t box2{std::allocator_arg, propagating_allocator<std::string>{&b}, idym::in_place, "b"};
+        box2 = box1;
+        idym_test::validate(*box2 == "a" && box2.get() != box1.get() && a.live == 2 && b.live == 0, "memory.boxed.copy_assign");
+        idym_test::validate(box2.get_allocator().source == &a, "memory.boxed.copy_assign");
+
+        box_t box3{std::allocator_arg, propagating_allocator<std::string>{&b}, idym::in_place, "c"};
+        const std::string* contents = box1.get();
+        box3 = std::move(box1);
+        idym_test::validate(!box1 && box3.get() == contents && a.live == 2 && b.live == 0, "memory.boxed.move_assign");
+        idym_test::validate(box3.get_allocator().source == &a, "memory.boxed.move_assign");
+    }
+    idym_test::validate(a.live == 0 && b.live == 0 && a.total == 2 && b.total == 2, "memory.boxed.dtor");
+}
+
+}
+
+int main(int, char**) {
+    memory_relocate::run_relocate_n();
+    memory_relocate::run_swap();
+    memory_boxed::run_boxed();
+    memory_boxed::run_boxed_propagate();
+
+    return 0;
+}
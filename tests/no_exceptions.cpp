@@ -0,0 +1,120 @@
+#include <csetjmp>
+#include <cstring>
+
+#include <idym/variant.hpp>
+#include <idym/expected.hpp>
+#include <idym/compact_expected.hpp>
+
+#include "idym_test.hpp"
+
+#ifndef IDYM_NO_EXCEPTIONS
+  #error "expected to be built with exceptions disabled"
+#endif
+
+namespace {
+std::jmp_buf handler_target;
+const char* handled_what = nullptr;
+
+[[noreturn]] void jump_handler(const std::exception& e) {
+    handled_what = e.what();
+    std::longjmp(handler_target, 1);
+}
+}
+
+// the handler jumps back in place of a throw, nothing in between owns resources
+#define IDYM_VALIDATE_HANDLER(STR, WHAT, ...) \
+    do { \
+        bool handled = false; \
+        handled_what = nullptr; \
+        if (setjmp(handler_target) == 0) { __VA_ARGS__; } \
+        else { handled = true; } \
+        ::idym_test::validate(handled && std::strcmp(handled_what, WHAT) == 0, STR); \
+    } while(false)
+
+constexpr const char* variant_what = "Bad variant access. Too bad!";
+constexpr const char* expected_what = "Bad expected access. Too bad!";
+
+// moves without noexcept, picks the paths that would back up and restore with exceptions
+struct throwing_move {
+    throwing_move(int v) : value{v} {}
+    throwing_move(const throwing_move&) = default;
+    throwing_move(throwing_move&& other) : value{other.value} {}
+    throwing_move& operator=(const throwing_move&) = default;
+    throwing_move& operator=(throwing_move&&) = default;
+
+    int value;
+};
+
+namespace no_exceptions_handler {
+
+void run_handler() {
+    idym_test::validate(idym::get_throw_handler() == nullptr, "no_exceptions.handler");
+    idym_test::validate(idym::set_throw_handler(jump_handler) == nullptr, "no_exceptions.handler");
+    idym_test::validate(idym::get_throw_handler() == jump_handler, "no_exceptions.handler");
+}
+
+}
+
+namespace no_exceptions_variant {
+
+void run_variant() {
+    idym::variant<int, float> var{5};
+
+    idym_test::validate(idym::get<0>(var) == 5 && idym::get<int>(var) == 5, "no_exceptions.variant.get");
+    IDYM_VALIDATE_HANDLER("no_exceptions.variant.get", variant_what, idym::get<1>(var));
+    IDYM_VALIDATE_HANDLER("no_exceptions.variant.get", variant_what, idym::get<float>(var));
+
+    var = 2.0f;
+    idym_test::validate(idym::visit([](auto v) { return static_cast<int>(v); }, var) == 2, "no_exceptions.variant.visit");
+
+    idym::variant<int, throwing_move> move_var{throwing_move{3}};
+    var.emplace<0>(1);
+    move_var = 4;
+    idym_test::validate(idym::get<0>(move_var) == 4, "no_exceptions.variant.assign");
+}
+
+}
+
+namespace no_exceptions_expected {
+
+void run_expected() {
+    idym::expected<int, int> ex{5};
+    idym::expected<int, int> unex{idym::unexpect, 7};
+    idym::expected<void, int> void_unex{idym::unexpect, 7};
+
+    idym_test::validate(ex.value() == 5, "no_exceptions.expected.value");
+    IDYM_VALIDATE_HANDLER("no_exceptions.expected.value", expected_what, unex.value());
+    IDYM_VALIDATE_HANDLER("no_exceptions.expected.value", expected_what, std::move(unex).value());
+    IDYM_VALIDATE_HANDLER("no_exceptions.expected.value", expected_what, void_unex.value());
+
+    const idym::compact_expected<void, int, 0> compact_unex{idym::unexpect, 7};
+    IDYM_VALIDATE_HANDLER("no_exceptions.compact_expected.value", expected_what, compact_unex.value());
+}
+
+void run_reinit() {
+    idym::expected<throwing_move, int> ex{idym::in_place, 1};
+    idym::expected<throwing_move, int> unex{idym::unexpect, 2};
+
+    ex.swap(unex);
+    idym_test::validate(!ex.has_value() && ex.error() == 2, "no_exceptions.expected.swap");
+    idym_test::validate(unex.has_value() && unex->value == 1, "no_exceptions.expected.swap");
+
+    ex = unex;
+    idym_test::validate(ex.has_value() && ex->value == 1, "no_exceptions.expected.assign");
+    unex = idym::unexpected<int>{3};
+    ex = unex;
+    idym_test::validate(!ex.has_value() && ex.error() == 3, "no_exceptions.expected.assign");
+    ex = throwing_move{4};
+    idym_test::validate(ex.has_value() && ex->value == 4, "no_exceptions.expected.assign");
+}
+
+}
+
+int main(int, char**) {
+    no_exceptions_handler::run_handler();
+    no_exceptions_variant::run_variant();
+    no_exceptions_expected::run_expected();
+    no_exceptions_expected::run_reinit();
+
+    return 0;
+}
@@ -1,6 +1,9 @@
+#include <string>
+
 #include <idym/variant.hpp>
 
 #include "idym_test.hpp"
+#include "variant_tables.hpp"
 
 #define IDYM_VALIDATE_BAD_ACCESS(STR, ...) IDYM_VALIDATE_EXCEPTION_GENERIC(STR, idym::bad_variant_access, __VA_ARGS__)
 
@@ -153,6 +156,28 @@ void run_14_19() {
         idym_test::validate(idym::get<1>(v).state_flag == 2, "variant.ctor.17");
     }
     IDYM_VALIDATE_EXCEPTION("variant.ctor.18", idym::variant<ptr_ctor, int>{nullptr});
+
+    struct no_copy {
+        no_copy() = default;
+        no_copy(const no_copy&) = delete;
+    };
+    struct from_no_copy {
+        from_no_copy(const no_copy&) {}
+    };
+
+    static_assert(!std::is_constructible<idym::variant<int, const int>, int>::value, "variant.ctor.15");
+    static_assert(std::is_constructible<idym::variant<long, const int>, int&>::value, "variant.ctor.15");
+    {
+        const no_copy value{};
+        idym::variant<no_copy, from_no_copy> v{value};
+        idym_test::validate(v.index() == 1, "variant.ctor.17");
+    }
+    {
+        idym::variant<long, int> v{1};
+        idym_test::validate(v.index() == 1, "variant.ctor.17");
+        v = 2l;
+        idym_test::validate(v.index() == 0, "variant.ctor.17");
+    }
 }
 void run_20_29() {
     struct init_list_type {
@@ -586,6 +611,70 @@ void run_1_5() {
     }
 }
 
+struct counted {
+    counted(int v) : value{v} { ++live_count; }
+    counted(const counted& other) : value{other.value} { ++live_count; }
+    counted(counted&& other) noexcept : value{other.value} { ++live_count; ++move_count; }
+    ~counted() { --live_count; ++destroy_count; }
+
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+
+    static void reset() { move_count = 0; destroy_count = 0; }
+
+    static int live_count;
+    static int move_count;
+    static int destroy_count;
+    int value;
+};
+int counted::live_count = 0;
+int counted::move_count = 0;
+int counted::destroy_count = 0;
+
+void run_relocate() {
+    {
+        idym::variant<counted, int> v1{idym::in_place_index<0>, 5};
+        idym::variant<counted, int> v2{idym::in_place_index<1>, 4};
+
+        counted::reset();
+        v1.swap(v2);
+        idym_test::validate(counted::live_count == 1, "variant.swap.relocate");
+        idym_test::validate(counted::move_count == 1 && counted::destroy_count == 1, "variant.swap.relocate");
+        idym_test::validate(idym::get<1>(v1) == 4 && idym::get<0>(v2).value == 5, "variant.swap.relocate");
+
+        v1.swap(v2);
+        idym_test::validate(counted::live_count == 1, "variant.swap.relocate");
+        idym_test::validate(idym::get<0>(v1).value == 5 && idym::get<1>(v2) == 4, "variant.swap.relocate");
+    }
+    idym_test::validate(counted::live_count == 0, "variant.swap.relocate");
+    {
+        idym::variant<counted, int, counted> v1{idym::in_place_index<0>, 1};
+        idym::variant<counted, int, counted> v2{idym::in_place_index<2>, 2};
+
+        counted::reset();
+        v1.swap(v2);
+        idym_test::validate(counted::live_count == 2, "variant.swap.relocate");
+        idym_test::validate(counted::move_count == 3 && counted::destroy_count == 3, "variant.swap.relocate");
+        idym_test::validate(idym::get<2>(v1).value == 2 && idym::get<0>(v2).value == 1, "variant.swap.relocate");
+    }
+    idym_test::validate(counted::live_count == 0, "variant.swap.relocate");
+    {
+        auto v1 = make_valueless<counted>();
+        valueless_var_t<counted> v2{idym::in_place_index<2>, 3};
+
+        counted::reset();
+        v1.swap(v2);
+        idym_test::validate(counted::live_count == 1, "variant.swap.relocate");
+        idym_test::validate(counted::move_count == 1 && counted::destroy_count == 1, "variant.swap.relocate");
+        idym_test::validate(v2.valueless_by_exception() && idym::get<2>(v1).value == 3, "variant.swap.relocate");
+
+        v2.swap(v1);
+        idym_test::validate(counted::live_count == 1, "variant.swap.relocate");
+        idym_test::validate(v1.valueless_by_exception() && idym::get<2>(v2).value == 3, "variant.swap.relocate");
+    }
+    idym_test::validate(counted::live_count == 0, "variant.swap.relocate");
+}
+
 }
 
 // [variant.helper]
@@ -597,6 +686,18 @@ static_assert(idym::variant_size_v<const idym::variant<int, char, char>> == 3, "
 static_assert(std::is_same<char, idym::variant_alternative_t<1, idym::variant<int, char, char>>>::value, "variant.helper.3");
 static_assert(std::is_same<int, idym::variant_alternative_t<0, const idym::variant<int, char, char>>>::value, "variant.helper.3");
 
+template<typename T, typename = void>
+struct has_type : std::false_type {};
+template<typename T>
+struct has_type<T, idym::void_t<typename T::type>> : std::true_type {};
+
+static_assert(std::is_same<char, idym::_internal::index_to_alternative_t<2, int, char, char>>::value, "variant.helper.lookup");
+static_assert(!has_type<idym::_internal::index_to_alternative<3, int, char, char>>::value, "variant.helper.lookup");
+static_assert(idym::_internal::alternative_to_index<0, char, int, char, char>::value == 1, "variant.helper.lookup");
+static_assert(idym::_internal::alternative_to_index<0, float, int, char, char>::value == idym::variant_npos, "variant.helper.lookup");
+static_assert(idym::_internal::type_occurrence_count<char, int, char, char>::value == 2, "variant.helper.lookup");
+static_assert(idym::_internal::type_occurrence_count<float>::value == 0, "variant.helper.lookup");
+
 }
 
 // [variant.get]
@@ -657,6 +758,31 @@ void run_10_13() {
         static_assert(std::is_same<decltype(idym::get_if<int>(&cv1)), const int*>::value, "variant.get.13");
     }
 }
+// implementation specific, unchecked access
+void run_unchecked() {
+    {
+        const idym::variant<int, char> v1{'a'};
+        idym_test::validate(idym::get_unchecked<1>(v1) == 'a', "variant.get.unchecked");
+        idym_test::validate(idym::get_unchecked<char>(v1) == 'a', "variant.get.unchecked");
+        idym_test::validate(*idym::get_if_unchecked<1>(&v1) == 'a', "variant.get.unchecked");
+    }
+    {
+        idym::variant<int, char> v1{5};
+        const auto& cv1 = v1;
+
+        idym::get_unchecked<0>(v1) = 6;
+        idym_test::validate(idym::get<0>(v1) == 6, "variant.get.unchecked");
+        *idym::get_if_unchecked<int>(&v1) = 7;
+        idym_test::validate(&idym::get_unchecked<int>(cv1) == idym::get_if<int>(&v1) && idym::get<0>(v1) == 7, "variant.get.unchecked");
+
+        static_assert(noexcept(idym::get_unchecked<0>(v1)), "variant.get.unchecked");
+        static_assert(std::is_same<decltype(idym::get_unchecked<0>(v1)), int&>::value, "variant.get.unchecked");
+        static_assert(std::is_same<decltype(idym::get_unchecked<0>(std::move(v1))), int&&>::value, "variant.get.unchecked");
+        static_assert(std::is_same<decltype(idym::get_unchecked<int>(cv1)), const int&>::value, "variant.get.unchecked");
+        static_assert(std::is_same<decltype(idym::get_unchecked<int>(std::move(cv1))), const int&&>::value, "variant.get.unchecked");
+        static_assert(std::is_same<decltype(idym::get_if_unchecked<0>(&cv1)), const int*>::value, "variant.get.unchecked");
+    }
+}
 
 }
 
@@ -892,6 +1018,435 @@ void run_1_8() {
         IDYM_VALIDATE_BAD_ACCESS("variant.visit.7", visit(visitor{}, v1, v2, v3));
     }
 }
+// implementation specific, unchecked visit
+struct int_visitor {
+    template<typename T>
+    constexpr int operator()(T v) const {
+        return static_cast<int>(v);
+    }
+};
+
+void run_unchecked() {
+    idym::variant<visit_type<0>, visit_type<1>> v1{idym::in_place_type<visit_type<1>>};
+    idym::variant<visit_type<1>, visit_type<2>, visit_type<3>> v2{idym::in_place_type<visit_type<3>>};
+    const idym::variant<visit_type<2>, visit_type<3>, visit_type<4>, visit_type<5>> v3{idym::in_place_type<visit_type<5>>};
+
+    void* ret = idym::visit_unchecked(visitor{}, v1, v2, v3);
+    idym_test::validate(ret == &idym::get<1>(v1), "variant.visit.unchecked");
+
+    v2.emplace<0>();
+    ret = idym::visit_unchecked<void*>(visitor{}, v1, v2, v3);
+    idym_test::validate(!ret, "variant.visit.unchecked");
+
+    const idym::variant<int, long> v4{3l};
+    idym_test::validate(idym::visit_unchecked(int_visitor{}, v4) == 3, "variant.visit.unchecked");
+}
+// implementation specific, visit with an expected alternative
+void run_likely() {
+    struct ref_visitor {
+        int operator()(int& v) const { return v; }
+        int operator()(int&& v) const { return v + 10; }
+        int operator()(const int& v) const { return v + 20; }
+        int operator()(const std::string& v) const { return static_cast<int>(v.size()); }
+    };
+
+    idym::variant<int, std::string> v{5};
+    idym_test::validate(idym::visit_likely<0>(ref_visitor{}, v) == 5, "variant.visit.likely");
+    idym_test::validate(idym::visit_likely<1>(ref_visitor{}, v) == 5, "variant.visit.likely");
+    idym_test::validate(idym::visit_likely<0>(ref_visitor{}, std::move(v)) == 15, "variant.visit.likely");
+    idym_test::validate(idym::visit_likely<1, long>(ref_visitor{}, std::move(v)) == 15, "variant.visit.likely");
+
+    v = "four";
+    idym_test::validate(idym::visit_likely<0>(ref_visitor{}, v) == 4, "variant.visit.likely");
+    idym_test::validate(idym::visit_likely<1>(ref_visitor{}, idym::as_const(v)) == 4, "variant.visit.likely");
+
+    const auto valueless = make_valueless();
+    IDYM_VALIDATE_BAD_ACCESS("variant.visit.likely", idym::visit_likely<0>(visitor{}, valueless));
+
+    const idym::variant<int, long> v2{3l};
+    static_assert(std::is_same<decltype(idym::visit_likely<1>(int_visitor{}, v2)), int>::value, "");
+    idym_test::validate(idym::visit_likely<1>(int_visitor{}, v2) == 3, "variant.visit.likely");
+}
+
+}
+
+// [variant.hash]
+namespace variant_hash {
+
+struct not_hashable {};
+
+static_assert(std::is_default_constructible<std::hash<idym::variant<int, std::string>>>::value, "variant.hash.1");
+static_assert(std::is_default_constructible<std::hash<idym::variant<const int, std::string>>>::value, "variant.hash.1");
+static_assert(!std::is_default_constructible<std::hash<idym::variant<int, not_hashable>>>::value, "variant.hash.1");
+static_assert(!std::is_copy_constructible<std::hash<idym::variant<int, not_hashable>>>::value, "variant.hash.1");
+static_assert(std::is_default_constructible<std::hash<idym::monostate>>::value, "variant.hash.2");
+
+void run_1_2() {
+    using var_t = idym::variant<int, unsigned, std::string>;
+    const std::hash<var_t> hasher{};
+
+    idym_test::validate(hasher(var_t{1}) == hasher(var_t{1}), "variant.hash.1");
+    idym_test::validate(hasher(var_t{std::string{"key"}}) == hasher(var_t{std::string{"key"}}), "variant.hash.1");
+    idym_test::validate(hasher(var_t{1}) != hasher(var_t{1u}), "variant.hash.index");
+    idym_test::validate(hasher(var_t{1}) != hasher(var_t{2}), "variant.hash.index");
+
+    idym_test::validate(std::hash<idym::monostate>{}(idym::monostate{}) == std::hash<idym::monostate>{}(idym::monostate{}), "variant.hash.2");
+}
+
+}
+
+// implementation specific, index storage layout
+namespace variant_layout {
+
+static_assert(sizeof(idym::variant<char, bool>) == 2, "variant.layout.index");
+static_assert(sizeof(idym::variant<short, char>) == 4, "variant.layout.index");
+static_assert(sizeof(idym::variant<int, float>) == 8, "variant.layout.index");
+static_assert(sizeof(idym::variant<char, double>) == 2 * sizeof(double), "variant.layout.index");
+
+static_assert(std::is_same<idym::_internal::variant_index_t<254>, unsigned char>::value, "variant.layout.index");
+static_assert(std::is_same<idym::_internal::variant_index_t<255>, unsigned short>::value, "variant.layout.index");
+static_assert(std::is_same<idym::_internal::variant_index_t<65534>, unsigned short>::value, "variant.layout.index");
+static_assert(std::is_same<idym::_internal::variant_index_t<65535>, std::size_t>::value, "variant.layout.index");
+
+struct alignas(16) over_aligned { char c; };
+
+template<typename T, std::size_t... Is>
+idym::variant<std::conditional_t<Is == 0, T, T>..., over_aligned> make_repeat_variant(std::index_sequence<Is...>);
+
+template<std::size_t N>
+using repeat_var_t = decltype(make_repeat_variant<char>(std::make_index_sequence<N - 1>{}));
+
+template<typename Var_T>
+using storage_t = decltype(std::declval<Var_T&>()._internal_base()._storage);
+
+template<typename>
+struct is_flat_storage : std::false_type {};
+template<typename... Ts>
+struct is_flat_storage<idym::_internal::variant_storage_flat<Ts...>> : std::true_type {};
+
+constexpr std::size_t flat_threshold = IDYM_VARIANT_FLAT_STORAGE_THRESHOLD;
+
+static_assert(!is_flat_storage<storage_t<repeat_var_t<flat_threshold>>>::value, "variant.layout.flat");
+static_assert(is_flat_storage<storage_t<repeat_var_t<flat_threshold + 1>>>::value, "variant.layout.flat");
+static_assert(alignof(storage_t<repeat_var_t<flat_threshold + 1>>) == 16, "variant.layout.flat");
+static_assert(sizeof(storage_t<repeat_var_t<flat_threshold + 1>>) == 16, "variant.layout.flat");
+static_assert(sizeof(repeat_var_t<flat_threshold + 1>) == 32, "variant.layout.flat");
+static_assert(sizeof(repeat_var_t<flat_threshold + 1>) == sizeof(repeat_var_t<flat_threshold>), "variant.layout.flat");
+
+}
+
+// implementation specific, dispatch over a large pack of distinct alternatives
+namespace variant_dispatch {
+
+template<std::size_t I>
+struct chunk_type {
+    chunk_type(int* dtor_count) : dtor_count{dtor_count} {}
+    chunk_type(const chunk_type& other) : value{other.value + 1}, dtor_count{other.dtor_count} {}
+    ~chunk_type() { ++(*dtor_count); }
+
+    chunk_type& operator=(const chunk_type& other) {
+        value = other.value + 2;
+        return *this;
+    }
+
+    friend bool operator==(const chunk_type& lhs, const chunk_type& rhs) { return lhs.value == rhs.value; }
+    friend bool operator<(const chunk_type& lhs, const chunk_type& rhs) { return lhs.value < rhs.value; }
+
+    std::size_t value = I;
+    int* dtor_count;
+};
+
+template<std::size_t... Is>
+idym::variant<chunk_type<Is>...> make_chunk_variant(std::index_sequence<Is...>);
+
+using chunk_var_t = decltype(make_chunk_variant(std::make_index_sequence<40>{}));
+
+static_assert(
+    variant_layout::is_flat_storage<variant_layout::storage_t<chunk_var_t>>::value == (40 > IDYM_VARIANT_FLAT_STORAGE_THRESHOLD),
+    "variant.layout.flat"
+);
+
+void run_large_pack() {
+    {
+        int dtor_count = 0;
+        {
+            chunk_var_t v1{idym::in_place_index<37>, &dtor_count};
+            chunk_var_t v2{v1};
+            idym_test::validate(v2.index() == 37, "variant.dispatch.copy");
+            idym_test::validate(idym::get<37>(v2).value == 38, "variant.dispatch.copy");
+            idym_test::validate(idym::visit([](const auto& alt) { return alt.value; }, v1) == 37, "variant.dispatch.visit");
+            
+            v2.emplace<16>(&dtor_count);
+            idym_test::validate(dtor_count == 1, "variant.dispatch.destroy");
+            idym_test::validate(!(v1 == v2) && v2 < v1, "variant.dispatch.relops");
+            
+            v2 = v1;
+            idym_test::validate(dtor_count == 2, "variant.dispatch.destroy");
+            idym_test::validate(idym::get<37>(v2).value == 38, "variant.dispatch.copy");
+            
+            v2 = v1;
+            idym_test::validate(idym::get<37>(v2).value == 39, "variant.dispatch.assign");
+            idym_test::validate(!(v1 == v2) && v1 < v2, "variant.dispatch.relops");
+        }
+        idym_test::validate(dtor_count == 4, "variant.dispatch.destroy");
+    }
+}
+
+template<int I>
+using int_c = std::integral_constant<int, I>;
+
+void run_multi_visit() {
+    using var3_t = idym::variant<int_c<0>, int_c<1>, int_c<2>>;
+    using var2_t = idym::variant<int_c<0>, int_c<1>>;
+    using var4_t = idym::variant<int_c<0>, int_c<1>, int_c<2>, int_c<3>>;
+
+    const auto encode = [](auto a, auto b, auto c) { return a.value * 100 + b.value * 10 + c.value; };
+    const var3_t v3s[] = {int_c<0>{}, int_c<1>{}, int_c<2>{}};
+    const var2_t v2s[] = {int_c<0>{}, int_c<1>{}};
+    const var4_t v4s[] = {int_c<0>{}, int_c<1>{}, int_c<2>{}, int_c<3>{}};
+    
+    bool all_match = true;
+    for (int a = 0; a < 3; ++a) {
+        for (int b = 0; b < 2; ++b) {
+            for (int c = 0; c < 4; ++c)
+                all_match = all_match && idym::visit(encode, v3s[a], v2s[b], v4s[c]) == a * 100 + b * 10 + c;
+        }
+    }
+    idym_test::validate(all_match, "variant.dispatch.multi");
+
+    int dtor_count = 0;
+    {
+        const chunk_var_t v1{idym::in_place_index<39>, &dtor_count};
+        const chunk_var_t v2{idym::in_place_index<17>, &dtor_count};
+        const auto value_diff = [](const auto& lhs, const auto& rhs) { return static_cast<int>(lhs.value) - static_cast<int>(rhs.value); };
+        idym_test::validate(idym::visit(value_diff, v1, v2) == 22, "variant.dispatch.multi");
+        idym_test::validate(idym::visit(value_diff, v2, v1) == -22, "variant.dispatch.multi");
+    }
+}
+
+template<typename Var_T>
+using base_t = std::remove_reference_t<decltype(std::declval<Var_T&>()._internal_base())>;
+
+struct throwing_copy {
+    throwing_copy(int v) : value{v} {}
+    throwing_copy(const throwing_copy& other) : value{other.value} {}
+    throwing_copy& operator=(const throwing_copy&) = default;
+    int value;
+};
+
+using mixed_var_t = idym::variant<int, std::string, double>;
+static_assert(base_t<mixed_var_t>::trivial_copy_mask == 0b101, "variant.dispatch.trivial");
+static_assert(base_t<mixed_var_t>::trivial_destroy_mask == 0b101, "variant.dispatch.trivial");
+static_assert(base_t<mixed_var_t>::alternative_sizes::table[2] == sizeof(double), "variant.dispatch.trivial");
+static_assert(base_t<idym::never_valueless_variant<int, throwing_copy>>::trivial_copy_mask == 0, "variant.dispatch.trivial");
+static_assert(base_t<idym::never_valueless_variant<int, throwing_copy>>::trivial_destroy_mask == 0b11, "variant.dispatch.trivial");
+
+void run_trivial_paths() {
+    {
+        const mixed_var_t v1{2.5};
+        mixed_var_t v2{v1};
+        idym_test::validate(v2.index() == 2 && idym::get<2>(v2) == 2.5, "variant.dispatch.trivial");
+
+        v2 = std::string(64, 'a');
+        mixed_var_t v3{std::move(v2)};
+        idym_test::validate(v3.index() == 1 && idym::get<1>(v3).size() == 64, "variant.dispatch.trivial");
+
+        v3 = v1;
+        idym_test::validate(v3.index() == 2 && idym::get<2>(v3) == 2.5, "variant.dispatch.trivial");
+        v3 = mixed_var_t{7};
+        idym_test::validate(v3.index() == 0 && idym::get<0>(v3) == 7, "variant.dispatch.trivial");
+        v3 = mixed_var_t{std::string(64, 'b')};
+        idym_test::validate(v3.index() == 1 && idym::get<1>(v3) == std::string(64, 'b'), "variant.dispatch.trivial");
+    }
+    {
+        idym::never_valueless_variant<int, throwing_copy> v1{3};
+        idym::never_valueless_variant<int, throwing_copy> v2{throwing_copy{4}};
+        v2 = v1;
+        idym_test::validate(v2.index() == 0 && idym::get<0>(v2) == 3, "variant.dispatch.trivial");
+        v1 = throwing_copy{5};
+        v2 = v1;
+        idym_test::validate(v2.index() == 1 && idym::get<1>(v2).value == 5, "variant.dispatch.trivial");
+    }
+}
+
+// runtime indexed tables are static members, variant_tables.cpp must see the same objects as this translation unit
+void run_table_storage() {
+    const void* visitor_table = &variant_tables::visitor_table_t::dispatch_table;
+    const void* alternative_sizes = &variant_tables::table_base_t::alternative_sizes::table;
+    idym_test::validate(visitor_table == variant_tables::other_visitor_table(), "variant.dispatch.table");
+    idym_test::validate(alternative_sizes == variant_tables::other_alternative_sizes(), "variant.dispatch.table");
+}
+
+}
+
+// never_valueless_variant, keeps a valid alternative through throwing assignments
+namespace variant_never_valueless {
+
+struct counted_throws {
+    counted_throws(int v = 0) : value{v} { ++live_count; }
+    counted_throws(const counted_throws& other) : value{other.value} { copy_or_throw(); }
+    counted_throws(counted_throws&& other) : value{other.value} { copy_or_throw(); }
+    ~counted_throws() { --live_count; }
+
+    counted_throws& operator=(const counted_throws&) = default;
+    counted_throws& operator=(counted_throws&&) = default;
+
+    void copy_or_throw() {
+        if (throw_next)
+            throw idym_test::test_exception{};
+        ++live_count;
+    }
+
+    static int live_count;
+    static bool throw_next;
+    int value;
+};
+int counted_throws::live_count = 0;
+bool counted_throws::throw_next = false;
+
+template<typename Var_T>
+using storage_t = decltype(std::declval<Var_T&>()._internal_base()._storage);
+
+static_assert(sizeof(idym::never_valueless_variant<int, float>) == sizeof(idym::variant<int, float>), "variant.never_valueless.layout");
+static_assert(!idym::_internal::is_double_storage<storage_t<idym::never_valueless_variant<int, float>>>::value, "variant.never_valueless.layout");
+static_assert(idym::_internal::is_double_storage<storage_t<idym::never_valueless_variant<int, counted_throws>>>::value, "variant.never_valueless.layout");
+static_assert(idym::variant_size_v<idym::never_valueless_variant<int, char, char>> == 3, "variant.never_valueless.helper");
+
+void run_assign() {
+    {
+        idym::never_valueless_variant<int, counted_throws> v{5};
+        const counted_throws source{7};
+
+        counted_throws::throw_next = true;
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.assign", v = source);
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.emplace", v.emplace<1>(source));
+        counted_throws::throw_next = false;
+        idym_test::validate(!v.valueless_by_exception() && idym::get<0>(v) == 5, "variant.never_valueless.assign");
+
+        v = source;
+        idym_test::validate(v.index() == 1 && idym::get<1>(v).value == 7, "variant.never_valueless.assign");
+        v.emplace<1>(9);
+        idym_test::validate(idym::get<1>(v).value == 9, "variant.never_valueless.emplace");
+
+        counted_throws::throw_next = true;
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.emplace", v.emplace<1>(source));
+        counted_throws::throw_next = false;
+        idym_test::validate(v.index() == 1 && idym::get<1>(v).value == 9, "variant.never_valueless.emplace");
+
+        v = 3;
+        idym_test::validate(v.index() == 0 && idym::get<0>(v) == 3, "variant.never_valueless.assign");
+    }
+    idym_test::validate(counted_throws::live_count == 0, "variant.never_valueless.destroy");
+    {
+        idym::never_valueless_variant<int, counted_throws> v1{1};
+        idym::never_valueless_variant<int, counted_throws> v2{counted_throws{2}};
+        
+        counted_throws::throw_next = true;
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.assign", v1 = v2);
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.assign", v1 = std::move(v2));
+        counted_throws::throw_next = false;
+        idym_test::validate(v1.index() == 0 && v2.index() == 1, "variant.never_valueless.assign");
+
+        v1 = v2;
+        idym_test::validate(idym::get<1>(v1).value == 2, "variant.never_valueless.assign");
+        v2 = 4;
+        v1 = std::move(v2);
+        idym_test::validate(idym::get<0>(v1) == 4, "variant.never_valueless.assign");
+    }
+    idym_test::validate(counted_throws::live_count == 0, "variant.never_valueless.destroy");
+}
+
+void run_swap() {
+    {
+        idym::never_valueless_variant<int, counted_throws> v1{1};
+        idym::never_valueless_variant<int, counted_throws> v2{counted_throws{2}};
+
+        v1.swap(v2);
+        idym_test::validate(idym::get<1>(v1).value == 2 && idym::get<0>(v2) == 1, "variant.never_valueless.swap");
+        std::swap(v1, v2);
+        idym_test::validate(idym::get<0>(v1) == 1 && idym::get<1>(v2).value == 2, "variant.never_valueless.swap");
+
+        counted_throws::throw_next = true;
+        IDYM_VALIDATE_EXCEPTION("variant.never_valueless.swap", v1.swap(v2));
+        counted_throws::throw_next = false;
+        idym_test::validate(!v1.valueless_by_exception() && !v2.valueless_by_exception(), "variant.never_valueless.swap");
+    }
+    idym_test::validate(counted_throws::live_count == 0, "variant.never_valueless.destroy");
+}
+
+void run_obs() {
+    const idym::never_valueless_variant<int, float> v1{2};
+    const idym::never_valueless_variant<int, float> v2{2.0f};
+
+    idym_test::validate(idym::holds_alternative<int>(v1) && idym::get_if<float>(&v2) != nullptr, "variant.never_valueless.get");
+    idym_test::validate(v1 != v2 && v1 < v2 && v1 == idym::never_valueless_variant<int, float>{2}, "variant.never_valueless.relops");
+    idym_test::validate(idym::visit([](auto a, auto b) { return static_cast<int>(a + b); }, v1, v2) == 4, "variant.never_valueless.visit");
+}
+
+}
+
+// implementation specific, boxed alternatives
+namespace variant_boxed {
+
+struct large {
+    large(int v) : value{v} {}
+
+    friend bool operator==(const large& lhs, const large& rhs) { return lhs.value == rhs.value; }
+    friend bool operator!=(const large& lhs, const large& rhs) { return lhs.value != rhs.value; }
+    friend bool operator<(const large& lhs, const large& rhs) { return lhs.value < rhs.value; }
+    friend bool operator>(const large& lhs, const large& rhs) { return lhs.value > rhs.value; }
+    friend bool operator<=(const large& lhs, const large& rhs) { return lhs.value <= rhs.value; }
+    friend bool operator>=(const large& lhs, const large& rhs) { return lhs.value >= rhs.value; }
+
+    int value;
+    unsigned char payload[512] = {};
+};
+
+struct ref_visitor {
+    int operator()(int& v) const { return v; }
+    int operator()(large& v) const { return v.value; }
+    int operator()(const int& v) const { return v + 10; }
+    int operator()(const large& v) const { return v.value + 10; }
+};
+
+using capped_t = idym::capped_variant<16, int, large>;
+
+static_assert(std::is_same<capped_t, idym::variant<int, idym::boxed<large>>>::value, "variant.boxed.capped");
+static_assert(sizeof(capped_t) <= 2 * sizeof(void*), "variant.boxed.capped");
+static_assert(idym::is_trivially_relocatable_v<capped_t>, "variant.boxed.capped");
+
+void run_boxed() {
+    capped_t v{large{5}};
+    idym_test::validate(idym::holds_alternative<large>(v) && !idym::holds_alternative<int>(v), "variant.boxed.holds_alternative");
+    idym_test::validate(idym::get<large>(v).value == 5 && idym::get<1>(v)->value == 5, "variant.boxed.get");
+    static_assert(std::is_same<decltype(idym::get<large>(std::move(v))), large&&>::value, "variant.boxed.get");
+    static_assert(std::is_same<decltype(idym::get_if<large>(&idym::as_const(v))), const large*>::value, "variant.boxed.get");
+    idym_test::validate(idym::get_if<large>(&v) == idym::get<1>(v).get() && idym::get_if<int>(&v) == nullptr, "variant.boxed.get");
+    idym_test::validate(idym::get_unchecked<large>(v).value == 5, "variant.boxed.get");
+
+    idym_test::validate(idym::visit(ref_visitor{}, v) == 5, "variant.boxed.visit");
+    idym_test::validate(idym::visit(ref_visitor{}, idym::as_const(v)) == 15, "variant.boxed.visit");
+    idym_test::validate(idym::visit_unchecked<long>(ref_visitor{}, v) == 5, "variant.boxed.visit");
+    idym_test::validate(idym::visit_likely<1>(ref_visitor{}, v) == 5, "variant.boxed.visit");
+    idym_test::validate(idym::visit([](const auto& lhs, int rhs) { return sizeof(lhs) + rhs; }, v, idym::variant<int>{2}) == sizeof(large) + 2, "variant.boxed.visit");
+
+    capped_t w{v};
+    idym_test::validate(idym::get<1>(w).get() != idym::get<1>(v).get() && w == v, "variant.boxed.copy");
+    w = large{6};
+    idym_test::validate(v < w && v != w, "variant.boxed.relops");
+    w = 3;
+    v.swap(w);
+    idym_test::validate(idym::get<int>(v) == 3 && idym::get<large>(w).value == 5, "variant.boxed.swap");
+
+    IDYM_VALIDATE_BAD_ACCESS("variant.boxed.get", idym::get<large>(v));
+
+    // boxes hash as their contents
+    using boxed_str_t = idym::variant<int, idym::boxed<std::string>>;
+    static_assert(!std::is_default_constructible<std::hash<capped_t>>::value, "variant.boxed.hash");
+    const boxed_str_t str{std::string{"str"}};
+    const idym::variant<int, std::string> unboxed_str{std::string{"str"}};
+    idym_test::validate(std::hash<boxed_str_t>{}(str) == std::hash<idym::variant<int, std::string>>{}(unboxed_str), "variant.boxed.hash");
+}
 
 }
 
@@ -913,10 +1468,12 @@ int main(int, char**) {
     variant_status::run_1_3();
     
     variant_swap::run_1_5();
+    variant_swap::run_relocate();
     
     variant_get::run_1_2();
     variant_get::run_3_9();
     variant_get::run_10_13();
+    variant_get::run_unchecked();
     
     variant_relops::run_1_2();
     variant_relops::run_3_4();
@@ -926,5 +1483,20 @@ int main(int, char**) {
     variant_relops::run_11_12();
     
     variant_visit::run_1_8();
+    variant_visit::run_unchecked();
+    variant_visit::run_likely();
+
+    variant_hash::run_1_2();
+    
+    variant_dispatch::run_large_pack();
+    variant_dispatch::run_multi_visit();
+    variant_dispatch::run_table_storage();
+    variant_dispatch::run_trivial_paths();
+
+    variant_never_valueless::run_assign();
+    variant_never_valueless::run_swap();
+    variant_never_valueless::run_obs();
+
+    variant_boxed::run_boxed();
     return 0;
 }
@@ -0,0 +1,117 @@
+#include <vector>
+
+#include <idym/variant_range.hpp>
+
+#include "idym_test.hpp"
+
+using var_t = idym::variant<int, float, char>;
+
+std::vector<var_t> make_range() {
+    std::vector<var_t> vars;
+    for (int i = 0; i < 30; ++i) {
+        if (i % 3 == 0)
+            vars.emplace_back(idym::in_place_index<2>, static_cast<char>(i));
+        else if (i % 5 == 0)
+            vars.emplace_back(idym::in_place_index<1>, static_cast<float>(i));
+        else
+            vars.emplace_back(idym::in_place_index<0>, i);
+    }
+    return vars;
+}
+
+// records the order of visited alternatives
+struct order_visitor {
+    void operator()(int v) { visited.push_back({0, static_cast<int>(v)}); }
+    void operator()(float v) { visited.push_back({1, static_cast<int>(v)}); }
+    void operator()(char v) { visited.push_back({2, static_cast<int>(v)}); }
+
+    struct entry {
+        std::size_t index;
+        int value;
+    };
+    std::vector<entry> visited;
+};
+
+namespace variant_range_visit {
+
+void run_visit() {
+    const auto vars = make_range();
+    order_visitor vis;
+    idym::visit_range(vis, vars.begin(), vars.end());
+    
+    idym_test::validate(vis.visited.size() == vars.size(), "variant_range.visit");
+    bool grouped = true;
+    for (std::size_t i = 1; i < vis.visited.size(); ++i) {
+        const auto& prev = vis.visited[i - 1];
+        const auto& cur = vis.visited[i];
+        grouped = grouped && (prev.index < cur.index || (prev.index == cur.index && prev.value < cur.value));
+    }
+    idym_test::validate(grouped, "variant_range.visit.order");
+    idym_test::validate(vis.visited.front().index == 0 && vis.visited.back().index == 2, "variant_range.visit.order");
+    
+    std::vector<var_t> empty;
+    order_visitor empty_vis;
+    idym::visit_range(empty_vis, empty.begin(), empty.end());
+    idym_test::validate(empty_vis.visited.empty(), "variant_range.visit.empty");
+}
+
+void run_mutate() {
+    auto vars = make_range();
+    idym::visit_range([](auto& alt) { alt += 1; }, vars.begin(), vars.end());
+    
+    bool all_incremented = true;
+    for (std::size_t i = 0; i < vars.size(); ++i) {
+        const int expected = static_cast<int>(i) + 1;
+        all_incremented = all_incremented && idym::visit([](auto alt) { return static_cast<int>(alt); }, vars[i]) == expected;
+    }
+    idym_test::validate(all_incremented, "variant_range.visit.mutate");
+}
+
+void run_indexed() {
+    const auto vars = make_range();
+    std::vector<int> restored(vars.size(), -1);
+    std::vector<std::size_t> restored_index(vars.size());
+    idym::visit_range_indexed([&](std::size_t pos, auto alt) {
+        restored[pos] = static_cast<int>(alt);
+        restored_index[pos] = vars[pos].index();
+    }, vars.data(), vars.data() + vars.size());
+
+    bool in_order = true;
+    for (std::size_t i = 0; i < vars.size(); ++i)
+        in_order = in_order && restored[i] == static_cast<int>(i) && restored_index[i] == vars[i].index();
+    idym_test::validate(in_order, "variant_range.visit_indexed");
+}
+
+}
+
+namespace variant_range_valueless {
+
+struct throws_on_move {
+    throws_on_move() = default;
+    throws_on_move(const throws_on_move&) = default;
+    throws_on_move(throws_on_move&&) { throw idym_test::test_exception{}; }
+    throws_on_move& operator=(const throws_on_move&) = default;
+    throws_on_move& operator=(throws_on_move&&) { throw idym_test::test_exception{}; }
+};
+
+void run_valueless() {
+    std::vector<idym::variant<int, throws_on_move>> vars(4);
+    try { vars[2] = throws_on_move{}; } catch (const idym_test::test_exception&) {}
+    idym_test::validate(vars[2].valueless_by_exception(), "variant_range.valueless");
+
+    int calls = 0;
+    IDYM_VALIDATE_EXCEPTION_GENERIC("variant_range.valueless", idym::bad_variant_access,
+        idym::visit_range([&calls](const auto&) { ++calls; }, vars.begin(), vars.end()));
+    idym_test::validate(calls == 0, "variant_range.valueless");
+}
+
+}
+
+int main(int, char**) {
+    variant_range_visit::run_visit();
+    variant_range_visit::run_mutate();
+    variant_range_visit::run_indexed();
+    variant_range_valueless::run_valueless();
+
+    return 0;
+}
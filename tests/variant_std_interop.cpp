@@ -0,0 +1,51 @@
+#include <string>
+#include <variant>
+
+#include <idym/variant.hpp>
+
+#include "idym_test.hpp"
+
+// idym calls are qualified, std::visit found by argument dependent lookup doesn't compete with them
+namespace variant_std_interop {
+
+struct large {
+    int value;
+    unsigned char payload[512] = {};
+};
+
+using capped_t = idym::capped_variant<16, int, large>;
+using std_alt_t = idym::variant<int, std::string>;
+
+void run_visit() {
+    const auto value = [](const auto& alt) -> int {
+        if constexpr (std::is_same_v<std::decay_t<decltype(alt)>, large>)
+            return alt.value;
+        else
+            return 0;
+    };
+
+    const capped_t v{large{5}};
+    idym_test::validate(idym::visit(value, v) == 5, "variant.std_interop.visit");
+    idym_test::validate(idym::visit_unchecked(value, v) == 5, "variant.std_interop.visit");
+    idym_test::validate(idym::visit_likely<0>(value, v) == 5, "variant.std_interop.visit");
+    idym_test::validate(idym::visit_likely<1>(value, v) == 5, "variant.std_interop.visit");
+
+    const std_alt_t s{std::string{"str"}};
+    idym_test::validate(idym::visit([](const auto& alt) { return sizeof(alt); }, s) == sizeof(std::string), "variant.std_interop.visit");
+    idym_test::validate(std::visit([](const auto& alt) { return sizeof(alt); }, std::variant<int, std::string>{1}) == sizeof(int), "variant.std_interop.visit");
+}
+
+void run_hash() {
+    using boxed_str_t = idym::variant<int, idym::boxed<std::string>>;
+    const boxed_str_t v{std::string{"str"}};
+    idym_test::validate(std::hash<boxed_str_t>{}(v) == std::hash<std_alt_t>{}(std_alt_t{std::string{"str"}}), "variant.std_interop.hash");
+}
+
+}
+
+int main(int, char**) {
+    variant_std_interop::run_visit();
+    variant_std_interop::run_hash();
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+#include "variant_tables.hpp"
+
+namespace variant_tables {
+
+const void* other_visitor_table() {
+    return &visitor_table_t::dispatch_table;
+}
+const void* other_alternative_sizes() {
+    return &table_base_t::alternative_sizes::table;
+}
+
+}
@@ -0,0 +1,27 @@
+#ifndef IDYM_TEST_VARIANT_TABLES_H
+#define IDYM_TEST_VARIANT_TABLES_H
+
+#include <idym/variant.hpp>
+
+// implementation specific, dispatch tables are shared by every translation unit instantiating them
+namespace variant_tables {
+
+using table_var_t = idym::variant<int, double>;
+using table_storage_t = decltype(std::declval<table_var_t&>()._internal_base()._storage);
+using table_base_t = std::remove_reference_t<decltype(std::declval<table_var_t&>()._internal_base())>;
+
+// the table a single variant visit_impl with destroy_alternative reads from
+using visitor_table_t = idym::_internal::flat_visitor_table<
+    void,
+    idym::_internal::flat_dispatch_radix<idym::variant_size<table_var_t>::value>,
+    idym::_internal::destroy_alternative&&,
+    table_storage_t&
+>;
+
+// defined in variant_tables.cpp
+const void* other_visitor_table();
+const void* other_alternative_sizes();
+
+}
+
+#endif
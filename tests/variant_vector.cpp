@@ -0,0 +1,157 @@
+#include <string>
+
+#include <idym/variant_vector.hpp>
+
+#include "idym_test.hpp"
+
+struct big_alternative {
+    unsigned char data[200] = {};
+};
+
+// counts live instances, copies throw on demand
+struct counted {
+    counted(int v) : value{v} { ++live_count; }
+    counted(const counted& other) : value{other.value} {
+        if (throw_on_copy)
+            throw idym_test::test_exception{};
+        ++live_count;
+    }
+    ~counted() { --live_count; }
+
+    static int live_count;
+    static bool throw_on_copy;
+    int value;
+};
+int counted::live_count = 0;
+bool counted::throw_on_copy = false;
+
+using vec_t = idym::variant_vector<int, std::string, big_alternative>;
+
+namespace variant_vector_mod {
+
+void run_emplace() {
+    vec_t vec;
+    idym_test::validate(vec.empty(), "variant_vector.empty");
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 10 == 0)
+            vec.emplace_back<std::string>("value " + std::to_string(i));
+        else
+            vec.emplace_back<0>(i);
+    }
+    vec.emplace_back<2>().data[0] = 7;
+
+    idym_test::validate(vec.size() == 101, "variant_vector.emplace");
+    idym_test::validate(vec.count<int>() == 90 && vec.count<1>() == 10 && vec.count<big_alternative>() == 1, "variant_vector.emplace");
+    idym_test::validate(vec.index(0) == 1 && vec.index(1) == 0 && vec.index(100) == 2, "variant_vector.index");
+    idym_test::validate(vec.get<1>(50) == "value 50" && vec.get<int>(51) == 51, "variant_vector.get");
+    idym_test::validate(vec.get<big_alternative>(100).data[0] == 7, "variant_vector.get");
+    IDYM_VALIDATE_EXCEPTION_GENERIC("variant_vector.get", idym::bad_variant_access, vec.get<0>(50));
+    idym_test::validate(vec.get_if<int>(50) == nullptr && *vec.get_if<0>(99) == 99, "variant_vector.get_if");
+
+    vec.pop_back();
+    vec.pop_back();
+    idym_test::validate(vec.size() == 99 && vec.count<2>() == 0 && vec.count<0>() == 89, "variant_vector.pop_back");
+
+    vec.clear();
+    idym_test::validate(vec.empty() && vec.count<1>() == 0, "variant_vector.clear");
+}
+
+void run_push_back() {
+    vec_t vec;
+    const idym::variant<int, std::string, big_alternative> v1{std::string{"copied"}};
+    idym::variant<int, std::string, big_alternative> v2{std::string{"moved"}};
+
+    vec.push_back(v1);
+    vec.push_back(std::move(v2));
+    vec.push_back(3);
+    idym_test::validate(vec.get<1>(0) == "copied" && vec.get<1>(1) == "moved" && vec.get<0>(2) == 3, "variant_vector.push_back");
+    idym_test::validate(idym::get<1>(v2).empty(), "variant_vector.push_back");
+
+    // argument aliases an element of the pool being grown
+    idym::variant_vector<std::string> aliased;
+    aliased.emplace_back<0>("first");
+    for (int i = 0; i < 16; ++i)
+        aliased.emplace_back<0>(aliased.get<0>(0));
+    idym_test::validate(aliased.get<0>(16) == "first", "variant_vector.emplace");
+}
+
+void run_exceptions() {
+    {
+        idym::variant_vector<counted, int> vec;
+        vec.reserve<0>(4);
+        for (int i = 0; i < 4; ++i)
+            vec.emplace_back<0>(i);
+
+        const counted source{9};
+        counted::throw_on_copy = true;
+        IDYM_VALIDATE_EXCEPTION("variant_vector.emplace", vec.emplace_back<0>(source));
+        counted::throw_on_copy = false;
+        idym_test::validate(vec.size() == 4 && vec.count<0>() == 4, "variant_vector.emplace");
+        idym_test::validate(counted::live_count == 5, "variant_vector.emplace");
+
+        idym::variant_vector<counted, int> copy{vec};
+        idym_test::validate(copy.get<0>(3).value == 3 && counted::live_count == 9, "variant_vector.copy");
+    }
+    idym_test::validate(counted::live_count == 0, "variant_vector.destroy");
+}
+
+}
+
+namespace variant_vector_traverse {
+
+std::string describe(int v) { return std::to_string(v); }
+std::string describe(const std::string& s) { return s; }
+std::string describe(const big_alternative&) { return "big"; }
+
+void run_visit_all() {
+    vec_t vec;
+    vec.emplace_back<0>(1);
+    vec.emplace_back<1>("a");
+    vec.emplace_back<0>(2);
+    vec.emplace_back<1>("b");
+
+    std::string order;
+    vec.visit_all([&order](const auto& alt) { order += describe(alt); });
+    idym_test::validate(order == "12ab", "variant_vector.visit_all");
+    
+    int sum = 0;
+    vec.for_each<int>([&sum](int& v) { sum += v; v = 0; });
+    idym_test::validate(sum == 3 && vec.get<0>(2) == 0, "variant_vector.for_each");
+    
+    const vec_t& cvec = vec;
+    std::string joined;
+    cvec.for_each<1>([&joined](const std::string& s) { joined += s; });
+    idym_test::validate(joined == "ab", "variant_vector.for_each");
+}
+
+void run_copy_move() {
+    vec_t vec;
+    vec.emplace_back<1>("value");
+    vec.emplace_back<0>(4);
+
+    vec_t copy{vec};
+    vec_t moved{std::move(vec)};
+    idym_test::validate(copy.get<1>(0) == "value" && moved.get<0>(1) == 4, "variant_vector.copy");
+
+    vec_t other;
+    other.emplace_back<0>(8);
+    swap(other, copy);
+    idym_test::validate(other.size() == 2 && copy.size() == 1 && copy.get<0>(0) == 8, "variant_vector.swap");
+
+    other = copy;
+    idym_test::validate(other.size() == 1 && other.get<0>(0) == 8, "variant_vector.assign");
+}
+
+}
+
+int main(int, char**) {
+    variant_vector_mod::run_emplace();
+    variant_vector_mod::run_push_back();
+    variant_vector_mod::run_exceptions();
+
+    variant_vector_traverse::run_visit_all();
+    variant_vector_traverse::run_copy_move();
+
+    return 0;
+}